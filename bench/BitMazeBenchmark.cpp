@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include <bit>
+
+#include "BitMaze.h"
+#include "Fixtures.h"
+
+namespace
+{
+    constexpr size_t kMazeSize = 4096;
+}
+
+// Counts dead ends (cells with exactly one passage) cell by cell on the byte-per-cell grid
+static void BM_DeadEnds_CellGrid(benchmark::State& state)
+{
+    const Maze& maze = fixtures::sharedMaze(kMazeSize);
+
+    for (auto _ : state)
+    {
+        size_t deadEnds = 0;
+        for (size_t y = 0; y < maze.getHeight(); y++)
+        {
+            for (size_t x = 0; x < maze.getWidth(); x++)
+            {
+                deadEnds += std::popcount(maze.cell(x, y).getValue()) == 1;
+            }
+        }
+        benchmark::DoNotOptimize(deadEnds);
+    }
+    state.SetItemsProcessed(state.iterations() * maze.getWidth() * maze.getHeight());
+    state.counters["bytes/cell"] = sizeof(Cell);
+}
+BENCHMARK(BM_DeadEnds_CellGrid)->Unit(benchmark::kMillisecond);
+
+// Same count 64 cells at a time: a bit-sliced adder over the four passage words of each row word
+static void BM_DeadEnds_BitMaze(benchmark::State& state)
+{
+    const BitMaze maze(fixtures::sharedMaze(kMazeSize));
+    using word_type = BitMaze::word_type;
+
+    for (auto _ : state)
+    {
+        size_t deadEnds = 0;
+        for (size_t y = 0; y < maze.getHeight(); y++)
+        {
+            for (size_t w = 0; w < maze.getWordsPerRow(); w++)
+            {
+                word_type n = maze.passageWord(y, w, Direction::NORTH);
+                word_type e = maze.passageWord(y, w, Direction::EAST);
+                word_type s = maze.passageWord(y, w, Direction::SOUTH);
+                word_type wst = maze.passageWord(y, w, Direction::WEST);
+
+                word_type sum1 = n ^ e, carry1 = n & e;
+                word_type sum2 = s ^ wst, carry2 = s & wst;
+                // odd count without any pair of passages means exactly one
+                word_type exactlyOne = (sum1 ^ sum2) & ~(carry1 | carry2 | (sum1 & sum2));
+                deadEnds += std::popcount(exactlyOne & maze.validMask(w));
+            }
+        }
+        benchmark::DoNotOptimize(deadEnds);
+    }
+    state.SetItemsProcessed(state.iterations() * maze.getWidth() * maze.getHeight());
+    state.counters["bytes/cell"] = 2.0 / 8.0;
+}
+BENCHMARK(BM_DeadEnds_BitMaze)->Unit(benchmark::kMillisecond);
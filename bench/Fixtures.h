@@ -0,0 +1,39 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "Maze.h"
+#include "Pathfinding.h"
+
+namespace fixtures
+{
+    // Mazes are expensive to generate at benchmark sizes, so every size is generated once with a fixed seed
+    inline std::shared_ptr<Maze> sharedMazePtr(size_t size)
+    {
+        static std::map<size_t, std::shared_ptr<Maze>> mazes;
+        std::shared_ptr<Maze>& maze = mazes[size];
+        if (!maze)
+            maze = std::make_shared<Maze>(size, size, 1);
+        return maze;
+    }
+
+    inline const Maze& sharedMaze(size_t size)
+    {
+        return *sharedMazePtr(size);
+    }
+
+    // corner to corner path of the shared maze, its prefixes give queries of known length
+    inline const std::vector<Vec2i>& cornerPath(size_t size)
+    {
+        static std::map<size_t, std::vector<Vec2i>> paths;
+        std::vector<Vec2i>& path = paths[size];
+        if (path.empty())
+        {
+            Pathfinder finder(sharedMazePtr(size));
+            path = finder.invoke(Vec2i(0), Vec2i(size - 1), Vec2i::Manhattan);
+        }
+        return path;
+    }
+}
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include "MazeStream.h"
+#include "ParallelMaze.h"
+
+namespace
+{
+    // discards rows, measures the generator alone at O(width) memory
+    class NullRowSink : public MazeRowSink
+    {
+    public:
+        virtual void consumeRow(size_t, const Cell* row) override { benchmark::DoNotOptimize(row); }
+    };
+}
+
+static void BM_Eller_Stream(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    NullRowSink sink;
+
+    for (auto _ : state)
+    {
+        EllerMazeCreator::Generate(size, size, 1, sink);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_Eller_Stream)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+static void BM_Eller_Grid(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    Grid grid(size, size);
+    GridRowSink sink(grid);
+
+    for (auto _ : state)
+    {
+        EllerMazeCreator::Generate(size, size, 1, sink);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_Eller_Grid)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond);
+
+// Thread count scaling on a 4096x4096 maze, the output is identical for every thread count
+static void BM_ParallelMaze(benchmark::State& state)
+{
+    const size_t size = 4096;
+    ParallelMazeCreator creator(ParallelMazeCreator::DEFAULT_TILE_SIZE, std::make_shared<ThreadPool>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        Grid grid(size, size);
+        creator.Generate(grid, 1);
+        benchmark::DoNotOptimize(grid.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+    state.counters["threads"] = static_cast<double>(creator.GetThreadPool().getThreadCount());
+}
+BENCHMARK(BM_ParallelMaze)->ArgName("threads")->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Parameter-sweep shape: many small mazes, one pooled allocation, one RNG stream per maze
+static void BM_CarveBatch(benchmark::State& state)
+{
+    const size_t count = 10000;
+    ThreadPool pool(state.range(0));
+    double mazesPerSecond = 0.0;
+
+    for (auto _ : state)
+    {
+        MazeBatch batch = MazeFactory::CarveBatch(count, 64, 64, 1, &pool);
+        mazesPerSecond = batch.getMazesPerSecond();
+        benchmark::DoNotOptimize(batch.storage.get());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.counters["mazes/s"] = mazesPerSecond;
+}
+BENCHMARK(BM_CarveBatch)->ArgName("threads")->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
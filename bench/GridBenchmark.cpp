@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "Maze.h"
+#include "Fixtures.h"
+
+namespace
+{
+    constexpr size_t kMazeSize = 4096;
+
+    constexpr std::array<Direction, 4> kDirections = {
+        Direction::NORTH,
+        Direction::EAST,
+        Direction::SOUTH,
+        Direction::WEST,
+    };
+
+    /**
+     * @brief Replica of the previous nested-vector layout, one heap allocation per column and
+     * a bounds-checked .at() on both subscripts, kept here as the baseline
+     */
+    class LegacyGrid
+    {
+    public:
+        LegacyGrid(const Maze& maze)
+            : m_columns(maze.getWidth(), std::vector<Cell>(maze.getHeight()))
+        {
+            for (size_t x = 0; x < maze.getWidth(); x++)
+                for (size_t y = 0; y < maze.getHeight(); y++)
+                    m_columns.at(x).at(y) = maze.cell(x, y);
+        }
+
+        const Cell& at(size_t x, size_t y) const { return m_columns.at(x).at(y); }
+        size_t getWidth() const { return m_columns.size(); }
+        size_t getHeight() const { return m_columns[0].size(); }
+
+    private:
+        std::vector<std::vector<Cell>> m_columns;
+    };
+
+    Vec2i step(Direction dir)
+    {
+        switch (dir)
+        {
+        case Direction::NORTH: return Vec2i( 0, -1);
+        case Direction::EAST:  return Vec2i( 1,  0);
+        case Direction::SOUTH: return Vec2i( 0,  1);
+        default:               return Vec2i(-1,  0);
+        }
+    }
+}
+
+// Visits every neighbor of every cell the way Pathfinder::isWall used to: bounds check, then two .at() calls
+static void BM_NeighborScan_Legacy(benchmark::State& state)
+{
+    const LegacyGrid grid(fixtures::sharedMaze(kMazeSize));
+    const int32_t w = static_cast<int32_t>(grid.getWidth());
+    const int32_t h = static_cast<int32_t>(grid.getHeight());
+
+    for (auto _ : state)
+    {
+        size_t open = 0;
+        for (int32_t y = 0; y < h; y++)
+        {
+            for (int32_t x = 0; x < w; x++)
+            {
+                for (Direction dir : kDirections)
+                {
+                    Vec2i n = Vec2i(x, y) + step(dir);
+                    if (n.x < 0 || n.y < 0 || n.x >= w || n.y >= h)
+                        continue;
+                    if (grid.at(x, y).hasPath(dir) && grid.at(n.x, n.y).hasPath(getOpposite(dir)))
+                        ++open;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(open);
+    }
+    state.SetItemsProcessed(state.iterations() * w * h);
+}
+BENCHMARK(BM_NeighborScan_Legacy)->Unit(benchmark::kMillisecond);
+
+// Same scan on the flat buffer, neighbors are a fixed offset away and the sentinel border removes the bounds checks
+static void BM_NeighborScan_Flat(benchmark::State& state)
+{
+    const Grid& grid = fixtures::sharedMaze(kMazeSize).getGrid();
+    const Cell* cells = grid.data();
+    std::array<ptrdiff_t, 4> offsets;
+    for (size_t i = 0; i < kDirections.size(); i++)
+        offsets[i] = grid.offset(kDirections[i]);
+
+    for (auto _ : state)
+    {
+        size_t open = 0;
+        for (size_t y = 0; y < grid.getHeight(); y++)
+        {
+            size_t idx = grid.index(0, y);
+            for (size_t x = 0; x < grid.getWidth(); x++, idx++)
+            {
+                for (size_t i = 0; i < kDirections.size(); i++)
+                {
+                    if (cells[idx].hasPath(kDirections[i]) && cells[idx + offsets[i]].hasPath(getOpposite(kDirections[i])))
+                        ++open;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(open);
+    }
+    state.SetItemsProcessed(state.iterations() * grid.getWidth() * grid.getHeight());
+}
+BENCHMARK(BM_NeighborScan_Flat)->Unit(benchmark::kMillisecond);
+
+// The same scan through Grid::cell(x, y), the accessor everything outside the hot kernels goes through;
+// range(0) is the tile shift, 0 for the heap row-major grid and 6 for a memory-mapped tiled one
+static void BM_NeighborScan_Cell(benchmark::State& state)
+{
+    const size_t tileShift = static_cast<size_t>(state.range(0));
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "labyrinth_bench.grid";
+    const Maze maze(tileShift ? Grid::Mapped(kMazeSize, kMazeSize, path, tileShift) : Grid(kMazeSize, kMazeSize), 1);
+    const Grid& grid = maze.getGrid();
+
+    for (auto _ : state)
+    {
+        size_t open = 0;
+        for (size_t y = 0; y < grid.getHeight(); y++)
+        {
+            for (size_t x = 0; x < grid.getWidth(); x++)
+            {
+                const Cell& cell = grid.cell(x, y);
+                open += cell.hasPath(Direction::NORTH) && grid.cell(x, y - 1).hasPath(Direction::SOUTH);
+                open += cell.hasPath(Direction::EAST) && grid.cell(x + 1, y).hasPath(Direction::WEST);
+                open += cell.hasPath(Direction::SOUTH) && grid.cell(x, y + 1).hasPath(Direction::NORTH);
+                open += cell.hasPath(Direction::WEST) && grid.cell(x - 1, y).hasPath(Direction::EAST);
+            }
+        }
+        benchmark::DoNotOptimize(open);
+    }
+    state.SetItemsProcessed(state.iterations() * grid.getWidth() * grid.getHeight());
+}
+BENCHMARK(BM_NeighborScan_Cell)->ArgName("tileShift")->Arg(0)->Arg(6)->Unit(benchmark::kMillisecond);
+
+static void BM_UpdateMaze(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(0));
+    Maze maze(size, size, 1);
+
+    for (auto _ : state)
+    {
+        maze.UpdateMaze();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_UpdateMaze)->Arg(1024)->Arg(kMazeSize)->Unit(benchmark::kMillisecond);
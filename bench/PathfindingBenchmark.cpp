@@ -0,0 +1,325 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "Pathfinding.h"
+#include "PathOracle.h"
+#include "HierarchicalPathfinder.h"
+#include "DStarLite.h"
+#include "BatchPathfinder.h"
+#include "PathCache.h"
+#include "Fixtures.h"
+
+namespace
+{
+    constexpr size_t kMazeSize = 2048;
+
+    // goal reached after range(0) steps along the corner path
+    Vec2i goalAt(const benchmark::State& state)
+    {
+        const std::vector<Vec2i>& path = fixtures::cornerPath(kMazeSize);
+        return path[std::min<size_t>(state.range(0), path.size()) - 1];
+    }
+}
+
+// One workspace for all queries: per-query cost follows the nodes expanded
+static void BM_Query_ReusedWorkspace(benchmark::State& state)
+{
+    Pathfinder finder(fixtures::sharedMazePtr(kMazeSize));
+    const Vec2i goal = goalAt(state);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(finder.invoke(Vec2i(0), goal, Vec2i::Manhattan));
+    }
+    state.counters["expanded"] = static_cast<double>(finder.getExpandedCount());
+    state.counters["ns/expanded"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * finder.getExpandedCount()), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_Query_ReusedWorkspace)->ArgName("steps")->RangeMultiplier(16)->Range(4, 65536);
+
+// Fresh W x H state per query, what every invoke() used to pay through reset() and resize()
+static void BM_Query_FreshWorkspace(benchmark::State& state)
+{
+    const Vec2i goal = goalAt(state);
+    size_t expanded = 0;
+
+    for (auto _ : state)
+    {
+        Pathfinder finder(fixtures::sharedMazePtr(kMazeSize));
+        benchmark::DoNotOptimize(finder.invoke(Vec2i(0), goal, Vec2i::Manhattan));
+        expanded = finder.getExpandedCount();
+    }
+    state.counters["expanded"] = static_cast<double>(expanded);
+}
+BENCHMARK(BM_Query_FreshWorkspace)->ArgName("steps")->RangeMultiplier(16)->Range(4, 65536);
+
+// Open list comparison: range(0) selects heap / LIFO buckets / FIFO buckets
+static void BM_Query_OpenList(benchmark::State& state)
+{
+    static constexpr const char* labels[] = { "heap", "buckets-lifo", "buckets-fifo" };
+    const OpenListPolicy policy = state.range(0) == 0 ? OpenListPolicy::BINARY_HEAP : OpenListPolicy::BUCKETS;
+    const TieBreak tieBreak = state.range(0) == 2 ? TieBreak::FIFO : TieBreak::LIFO;
+
+    Pathfinder finder(fixtures::sharedMazePtr(kMazeSize), policy, tieBreak);
+    const Vec2i goal = fixtures::cornerPath(kMazeSize)[std::min<size_t>(state.range(1), fixtures::cornerPath(kMazeSize).size()) - 1];
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(finder.invoke(Vec2i(0), goal, Vec2i::Manhattan));
+    }
+    state.SetLabel(labels[state.range(0)]);
+    state.counters["expanded"] = static_cast<double>(finder.getExpandedCount());
+}
+BENCHMARK(BM_Query_OpenList)->ArgNames({ "list", "steps" })->ArgsProduct({ { 0, 1, 2 }, { 4096, 1 << 30 } })->Unit(benchmark::kMillisecond);
+
+// Kernel specialization: Vec2i::Manhattan dispatches to the inlined kernel, a lambda stays behind std::function
+static void BM_Query_Heuristic(benchmark::State& state)
+{
+    const size_t size = static_cast<size_t>(state.range(1));
+    Pathfinder finder(fixtures::sharedMazePtr(size));
+    const Vec2i goal = fixtures::cornerPath(size).back();
+    const Pathfinder::HeuristicFn heuristic = state.range(0) == 0
+        ? Pathfinder::HeuristicFn(Vec2i::Manhattan)
+        : Pathfinder::HeuristicFn([](const Vec2i& lhs, const Vec2i& rhs) { return Vec2i::Manhattan(lhs, rhs); });
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(finder.invoke(Vec2i(0), goal, heuristic));
+    }
+    state.SetLabel(state.range(0) == 0 ? "specialized" : "std::function");
+    state.counters["expanded"] = static_cast<double>(finder.getExpandedCount());
+    state.counters["ns/expanded"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * finder.getExpandedCount()), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_Query_Heuristic)->ArgNames({ "generic", "size" })->ArgsProduct({ { 0, 1 }, { 256, kMazeSize } })->Unit(benchmark::kMillisecond);
+
+// Search mode comparison along the corner path: range(0) selects A* / bidirectional BFS
+static void BM_Query_SearchMode(benchmark::State& state)
+{
+    Pathfinder finder(fixtures::sharedMazePtr(kMazeSize));
+    finder.setSearchMode(state.range(0) == 0 ? SearchMode::ASTAR : SearchMode::BIDIRECTIONAL);
+    const Vec2i goal = fixtures::cornerPath(kMazeSize)[std::min<size_t>(state.range(1), fixtures::cornerPath(kMazeSize).size()) - 1];
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(finder.invoke(Vec2i(0), goal, Vec2i::Manhattan));
+    }
+    state.SetLabel(state.range(0) == 0 ? "astar" : "bidirectional");
+    state.counters["expanded"] = static_cast<double>(finder.getExpandedCount());
+}
+BENCHMARK(BM_Query_SearchMode)->ArgNames({ "mode", "steps" })->ArgsProduct({ { 0, 1 }, { 4096, 65536, 1 << 30 } })->Unit(benchmark::kMillisecond);
+
+// Tree oracle on the perfect maze: no search, range(0) selects a full path / just the distance
+static void BM_Query_Oracle(benchmark::State& state)
+{
+    PathOracle oracle(fixtures::sharedMazePtr(kMazeSize));
+    const Vec2i goal = fixtures::cornerPath(kMazeSize)[std::min<size_t>(state.range(1), fixtures::cornerPath(kMazeSize).size()) - 1];
+
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+            benchmark::DoNotOptimize(oracle.path(Vec2i(0), goal));
+        else
+            benchmark::DoNotOptimize(oracle.distance(Vec2i(0), goal));
+    }
+    state.SetLabel(state.range(0) == 0 ? "path" : "distance");
+}
+BENCHMARK(BM_Query_Oracle)->ArgNames({ "mode", "steps" })->ArgsProduct({ { 0, 1 }, { 4096, 65536, 1 << 30 } });
+
+static void BM_Oracle_Build(benchmark::State& state)
+{
+    PathOracle oracle(fixtures::sharedMazePtr(kMazeSize));
+    for (auto _ : state)
+    {
+        oracle.build();
+    }
+    state.SetItemsProcessed(state.iterations() * kMazeSize * kMazeSize);
+}
+BENCHMARK(BM_Oracle_Build)->Unit(benchmark::kMillisecond);
+
+// HPA* along the corner path, compare with BM_Query_SearchMode/mode:0
+static void BM_Query_Hierarchical(benchmark::State& state)
+{
+    static HierarchicalPathfinder finder(fixtures::sharedMazePtr(kMazeSize));
+    const Vec2i goal = fixtures::cornerPath(kMazeSize)[std::min<size_t>(state.range(0), fixtures::cornerPath(kMazeSize).size()) - 1];
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(finder.find(Vec2i(0), goal));
+    }
+    state.counters["expanded"] = static_cast<double>(finder.getExpandedCount());
+}
+BENCHMARK(BM_Query_Hierarchical)->ArgName("steps")->Arg(4096)->Arg(65536)->Arg(1 << 30)->Unit(benchmark::kMillisecond);
+
+static void BM_Hierarchical_Build(benchmark::State& state)
+{
+    HierarchicalPathfinder finder(fixtures::sharedMazePtr(kMazeSize), state.range(0));
+    for (auto _ : state)
+    {
+        finder.build();
+    }
+    state.counters["entrances"] = static_cast<double>(finder.getEntranceCount());
+}
+BENCHMARK(BM_Hierarchical_Build)->ArgName("cluster")->Arg(16)->Arg(32)->Arg(64)->Unit(benchmark::kMillisecond);
+
+// Local repair after a wall break: one or two clusters instead of the whole abstraction
+static void BM_Hierarchical_Repair(benchmark::State& state)
+{
+    // private maze, the walls broken here must not leak into the shared fixture
+    auto maze = std::make_shared<Maze>(kMazeSize, kMazeSize, 1u);
+    HierarchicalPathfinder finder(maze);
+    std::mt19937 rng(7);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        maze->breakWall(Vec2i(rng() % (kMazeSize - 1), rng() % (kMazeSize - 1)), rng() % 2 ? Vec2i(1, 0) : Vec2i(0, 1));
+        state.ResumeTiming();
+
+        finder.update();
+    }
+}
+BENCHMARK(BM_Hierarchical_Repair)->Unit(benchmark::kMicrosecond);
+
+// Replanning after one wall break anywhere in the maze: range(0) selects D* Lite / A* from scratch
+static void BM_Replan_WallBreak(benchmark::State& state)
+{
+    // private maze, the walls broken here must not leak into the shared fixture
+    auto maze = std::make_shared<Maze>(kMazeSize, kMazeSize, 1u);
+    const Vec2i goal(kMazeSize - 1, kMazeSize - 1);
+    const Vec2i start(0, 0);
+    DStarLite planner(maze, goal);
+    Pathfinder finder(maze);
+    PackedPath path;
+    planner.replan(start, path);
+
+    std::mt19937 rng(7);
+    size_t expanded = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        const Vec2i pos(rng() % (kMazeSize - 1), rng() % (kMazeSize - 1));
+        maze->breakWall(pos, rng() % 2 ? Vec2i(1, 0) : Vec2i(0, 1));
+        state.ResumeTiming();
+
+        if (state.range(0) == 0)
+        {
+            planner.replan(start, path);
+            benchmark::DoNotOptimize(path.size());
+            expanded += planner.getExpandedCount();
+        }
+        else
+        {
+            benchmark::DoNotOptimize(finder.find(start, goal));
+            expanded += finder.getExpandedCount();
+        }
+    }
+    state.SetLabel(state.range(0) == 0 ? "dstar-lite" : "astar");
+    state.counters["expanded"] = benchmark::Counter(static_cast<double>(expanded), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_Replan_WallBreak)->ArgName("scratch")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// 1024 random queries on a 256 x 256 maze per batch, range(0) pool threads
+static void BM_Query_Batch(benchmark::State& state)
+{
+    constexpr size_t size = 256;
+    std::mt19937 rng(3);
+    std::vector<PathQuery> queries(1024);
+    for (PathQuery& query : queries)
+        query = { Vec2i(rng() % size, rng() % size), Vec2i(rng() % size, rng() % size) };
+
+    BatchPathfinder finder(fixtures::sharedMazePtr(size), std::make_shared<ThreadPool>(state.range(0)));
+    PathBatch batch;
+    for (auto _ : state)
+    {
+        finder.solve(queries, batch);
+        benchmark::DoNotOptimize(batch.steps.data());
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    state.counters["steps"] = static_cast<double>(batch.steps.size());
+}
+BENCHMARK(BM_Query_Batch)->ArgName("threads")->RangeMultiplier(2)->Range(1, 16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// 64 recurring queries on a 256 x 256 maze with a wall broken every range(0) queries
+static void BM_Query_Cached(benchmark::State& state)
+{
+    constexpr size_t size = 256;
+    auto maze = std::make_shared<Maze>(size, size, 1u);
+    PathCache cache(std::make_shared<Pathfinder>(maze), maze);
+    std::mt19937 rng(3);
+    std::vector<PathQuery> queries(64);
+    for (PathQuery& query : queries)
+        query = { Vec2i(rng() % size, rng() % size), Vec2i(rng() % size, rng() % size) };
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        if (++i % state.range(0) == 0)
+            maze->breakWall(Vec2i(rng() % (size - 1), rng() % (size - 1)), rng() % 2 ? Vec2i(1, 0) : Vec2i(0, 1));
+        const PathQuery& query = queries[rng() % queries.size()];
+        benchmark::DoNotOptimize(cache.invoke(query.start, query.goal).data());
+    }
+    state.counters["hit_rate"] = cache.getHitRate();
+    state.counters["revalidated"] = static_cast<double>(cache.getRevalidations());
+}
+BENCHMARK(BM_Query_Cached)->ArgName("break_every")->Arg(16)->Arg(256)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+// Query output: range(0) selects Vec2i vector / packed 2-bit steps, both from the same search
+static void BM_Query_Packed(benchmark::State& state)
+{
+    const std::vector<Vec2i>& corner = fixtures::cornerPath(kMazeSize);
+    Pathfinder finder(fixtures::sharedMazePtr(kMazeSize));
+    const Vec2i goal = corner[std::min<size_t>(state.range(1), corner.size()) - 1];
+    std::vector<Vec2i> path;
+    PackedPath packed;
+
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            path.clear();
+            finder.findInto(Vec2i(0), goal, path);
+            benchmark::DoNotOptimize(path.data());
+        }
+        else
+        {
+            finder.findPacked(Vec2i(0), goal, packed);
+            benchmark::DoNotOptimize(packed.size());
+        }
+    }
+    const size_t steps = state.range(0) == 0 ? path.size() : packed.size();
+    state.counters["bytes/step"] = state.range(0) == 0 ? double(sizeof(Vec2i)) : 0.25;
+    state.counters["steps"] = static_cast<double>(steps);
+}
+BENCHMARK(BM_Query_Packed)->ArgNames({ "packed", "steps" })->ArgsProduct({ { 0, 1 }, { 4096, 1 << 30 } })->Unit(benchmark::kMillisecond);
+
+// Following a whole path one step per move: range(0) selects vector + erase(begin) / packed cursor
+static void BM_Path_Follow(benchmark::State& state)
+{
+    const std::vector<Vec2i>& corner = fixtures::cornerPath(kMazeSize);
+    const std::vector<Vec2i> steps(corner.begin(), corner.begin() + std::min<size_t>(state.range(1), corner.size()));
+    const PackedPath packed = PackedPath::FromSteps(Vec2i(0), steps);
+
+    for (auto _ : state)
+    {
+        Vec2i pos(0);
+        if (state.range(0) == 0)
+        {
+            std::vector<Vec2i> path = steps;
+            while (!path.empty())
+            {
+                pos = path.front();
+                path.erase(path.begin());
+            }
+        }
+        else
+        {
+            for (PackedPath::Cursor cursor = packed.cursor(); !cursor.done(); )
+                pos = cursor.next();
+        }
+        benchmark::DoNotOptimize(pos);
+    }
+    state.SetItemsProcessed(state.iterations() * steps.size());
+}
+BENCHMARK(BM_Path_Follow)->ArgNames({ "packed", "steps" })->ArgsProduct({ { 0, 1 }, { 256, 4096, 65536 } })->Unit(benchmark::kMicrosecond);
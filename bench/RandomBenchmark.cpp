@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "Maze.h"
+#include "MazeCarver.h"
+#include "utility/RandomGenerator.h"
+
+// Bounded draws: range(0) selects mt19937 with a fresh uniform_int_distribution per call (the old
+// RandomGenerator::generateIndex) / xoshiro256** with Lemire's bound; range(1) is the bound
+static void BM_Random_Index(benchmark::State& state)
+{
+    static constexpr const char* labels[] = { "mt19937", "xoshiro256" };
+    const size_t bound = static_cast<size_t>(state.range(1));
+    std::mt19937 mt(1);
+    Xoshiro256 xoshiro(1);
+
+    for (auto _ : state)
+    {
+        size_t sum = 0;
+        for (size_t i = 0; i < 1024; i++)
+        {
+            if (state.range(0) == 0)
+                sum += std::uniform_int_distribution<size_t>(0, bound - 1)(mt);
+            else
+                sum += xoshiro.bounded(bound);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+    state.SetLabel(labels[state.range(0)]);
+}
+BENCHMARK(BM_Random_Index)->ArgNames({ "engine", "bound" })->ArgsProduct({ { 0, 1 }, { 4, 100, 1 << 20 } });
+
+// Keyed draws the robots make, no engine state at all
+static void BM_Random_Stateless(benchmark::State& state)
+{
+    uint64_t counter = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(RandomGenerator::generateIndexAt(0, 100, 1, 7, counter++));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Random_Stateless);
+
+// Seeding one stream per worker: range(0) selects seed_seq + mt19937 (what CarveBatch used) / Xoshiro256::stream
+static void BM_Random_Stream(benchmark::State& state)
+{
+    uint64_t index = 0;
+    for (auto _ : state)
+    {
+        if (state.range(0) == 0)
+        {
+            std::seed_seq seq = { 1u, static_cast<uint32_t>(index), static_cast<uint32_t>(index >> 32) };
+            std::mt19937 rng(seq);
+            benchmark::DoNotOptimize(rng());
+        }
+        else
+        {
+            Xoshiro256 rng = Xoshiro256::stream(1, index);
+            benchmark::DoNotOptimize(rng());
+        }
+        ++index;
+    }
+}
+BENCHMARK(BM_Random_Stream)->ArgName("xoshiro")->Arg(0)->Arg(1);
+
+// Whole backtracker carve of a 1024x1024 maze driven by either engine
+static void BM_Random_Carve(benchmark::State& state)
+{
+    static constexpr size_t size = 1024;
+    Grid grid(size, size);
+    const GridRegion whole = { 0, 0, size, size };
+
+    for (auto _ : state)
+    {
+        grid.reset();
+        if (state.range(0) == 0)
+        {
+            std::mt19937 rng(1);
+            CarveBacktracker(grid, whole, [&](size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(rng); });
+        }
+        else
+        {
+            Xoshiro256 rng(1);
+            CarveBacktracker(grid, whole, [&](size_t n) { return rng.bounded(n); });
+        }
+        benchmark::DoNotOptimize(grid.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_Random_Carve)->ArgName("xoshiro")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Robot.h"
+#include "TerminalRenderer.h"
+
+namespace
+{
+    constexpr size_t kMazeSize = 200;
+
+    // a 200x200 battle with robots heading for the center
+    struct Battle
+    {
+        std::shared_ptr<Maze> maze;
+        std::unique_ptr<RobotManager> robots;
+
+        explicit Battle(int64_t count)
+            : maze(std::make_shared<Maze>(kMazeSize, kMazeSize, 3u))
+            , robots(std::make_unique<RobotManager>(maze))
+        {
+            for (int64_t i = 0; i < count; i++)
+                robots->AddRobot<SimpleRobots>(Vec2i(i % kMazeSize, (i * 7) % kMazeSize), Vec2i(kMazeSize / 2));
+            robots->UpdatePaths();
+        }
+    };
+}
+
+// Whole frame every time, what the first frame and every frame before used to cost
+static void BM_Render_Full(benchmark::State& state)
+{
+    Battle battle(state.range(0));
+    const int fd = open("/dev/null", O_WRONLY);
+    TerminalRenderer renderer(fd);
+
+    for (auto _ : state)
+    {
+        renderer.invalidate();
+        renderer.render(battle.maze, *battle.robots);
+    }
+    state.SetBytesProcessed(state.iterations() * renderer.getOutput().size());
+
+    close(fd);
+}
+BENCHMARK(BM_Render_Full)->ArgName("robots")->Arg(200)->Unit(benchmark::kMicrosecond);
+
+// One tick between frames, only the cells the robots left and entered are sent
+static void BM_Render_Diff(benchmark::State& state)
+{
+    Battle battle(state.range(0));
+    const int fd = open("/dev/null", O_WRONLY);
+    TerminalRenderer renderer(fd);
+    renderer.render(battle.maze, *battle.robots);
+
+    RobotManager::StepCounts steps{};
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        if (battle.robots->GetArrivedCount() == battle.robots->GetRobotCount())
+            battle.robots->Reset();
+        battle.robots->Tick(steps);
+        state.ResumeTiming();
+
+        renderer.render(battle.maze, *battle.robots);
+        bytes += renderer.getOutput().size();
+    }
+    state.SetBytesProcessed(bytes);
+    state.counters["glyphs"] = benchmark::Counter(static_cast<double>(renderer.getChangedCount()));
+
+    close(fd);
+}
+BENCHMARK(BM_Render_Diff)->ArgName("robots")->Arg(200)->Arg(2000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include "Battle.h"
+#include "Tournament.h"
+#include "Robot.h"
+#include "Pathfinding.h"
+
+namespace
+{
+    constexpr size_t kMazeSize = 1024;
+}
+
+// range(0) robots sharing one goal replan after a wall break: one field update whatever the count
+static void BM_RobotUpdate_SharedField(benchmark::State& state)
+{
+    auto maze = std::make_shared<Maze>(kMazeSize, kMazeSize, 1u);
+    RobotManager manager(maze);
+    std::mt19937 rng(7);
+    for (int64_t i = 0; i < state.range(0); i++)
+        manager.AddRobot<SimpleRobots>(Vec2i(rng() % kMazeSize, rng() % kMazeSize), Vec2i(kMazeSize / 2));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        maze->breakWall(Vec2i(rng() % (kMazeSize - 1), rng() % (kMazeSize - 1)), rng() % 2 ? Vec2i(1, 0) : Vec2i(0, 1));
+        state.ResumeTiming();
+
+        manager.UpdatePaths();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RobotUpdate_SharedField)->ArgName("robots")->RangeMultiplier(100)->Range(1, 10000)->Unit(benchmark::kMicrosecond);
+
+// The same replan done the old way, one A* per robot
+static void BM_RobotUpdate_SearchPerRobot(benchmark::State& state)
+{
+    auto maze = std::make_shared<Maze>(kMazeSize, kMazeSize, 1u);
+    Pathfinder finder(maze);
+    std::mt19937 rng(7);
+    std::vector<Vec2i> robots(state.range(0));
+    for (Vec2i& pos : robots)
+        pos = Vec2i(rng() % kMazeSize, rng() % kMazeSize);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        maze->breakWall(Vec2i(rng() % (kMazeSize - 1), rng() % (kMazeSize - 1)), rng() % 2 ? Vec2i(1, 0) : Vec2i(0, 1));
+        state.ResumeTiming();
+
+        for (const Vec2i& pos : robots)
+            benchmark::DoNotOptimize(finder.find(pos, Vec2i(kMazeSize / 2)));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RobotUpdate_SearchPerRobot)->ArgName("robots")->Arg(1)->Arg(100)->Unit(benchmark::kMillisecond);
+
+// Per-move cost of following the field
+static void BM_Robot_FieldStep(benchmark::State& state)
+{
+    auto maze = std::make_shared<Maze>(kMazeSize, kMazeSize, 1u);
+    DistanceField field(maze, Vec2i(kMazeSize / 2));
+    const Vec2i start(0, 0);
+    Vec2i pos = start;
+
+    for (auto _ : state)
+    {
+        Vec2i next = field.nextStep(pos);
+        pos = next == pos ? start : next;
+        benchmark::DoNotOptimize(pos);
+    }
+}
+BENCHMARK(BM_Robot_FieldStep);
+
+// One tick over range(0) robots spread over the maze and sharing one goal, on range(1) threads (0 = no pool)
+static void BM_Robot_Tick(benchmark::State& state)
+{
+    auto maze = std::make_shared<Maze>(kMazeSize, kMazeSize, 1u);
+    std::shared_ptr<ThreadPool> pool = state.range(1) ? std::make_shared<ThreadPool>(state.range(1)) : nullptr;
+    RobotManager manager(maze, pool);
+    std::mt19937 rng(7);
+    for (int64_t i = 0; i < state.range(0); i++)
+        manager.AddRobot<SimpleRobots>(Vec2i(rng() % kMazeSize, rng() % kMazeSize), Vec2i(kMazeSize / 2));
+
+    RobotManager::StepCounts steps{};
+    for (auto _ : state)
+    {
+        manager.Tick(steps);
+        if (manager.GetArrivedCount() == manager.GetRobotCount())
+        {
+            state.PauseTiming();
+            manager.Reset();
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Robot_Tick)->ArgNames({ "robots", "threads" })->ArgsProduct({ { 10000, 1000000 }, { 0, 1, 2, 4, 8 } })->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// A whole headless battle of range(0) robots of every type, from the start until all of them arrived
+static void BM_Battle_Headless(benchmark::State& state)
+{
+    auto maze = std::make_shared<Maze>(256, 256, 1u);
+    BattleContext battle(maze);
+    RobotManager& manager = battle.GetRobotManager();
+    std::mt19937 rng(7);
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+        const Vec2i start(rng() % 256, rng() % 256);
+        switch (i % 3)
+        {
+        case 0: manager.AddRobot<SimpleRobots>(start, Vec2i(128)); break;
+        case 1: manager.AddRobot<AngryRobots>(start, Vec2i(128)); break;
+        default: manager.AddRobot<BoomRobots>(start, Vec2i(128), 5); break;
+        }
+    }
+
+    size_t ticks = 0;
+    for (auto _ : state)
+    {
+        ticks += battle.RunHeadless().ticks;
+        state.PauseTiming();
+        battle.Reset();
+        state.ResumeTiming();
+    }
+    state.counters["ticks/s"] = benchmark::Counter(static_cast<double>(ticks), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Battle_Headless)->ArgName("robots")->Arg(3)->Arg(3000)->Unit(benchmark::kMillisecond);
+
+// 256 default battles on 20x20 mazes spread over range(0) threads
+static void BM_Tournament(benchmark::State& state)
+{
+    TournamentConfig config;
+    config.battles = 256;
+    Tournament tournament(config, std::make_shared<ThreadPool>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(tournament.run());
+    }
+    state.SetItemsProcessed(state.iterations() * config.battles);
+}
+BENCHMARK(BM_Tournament)->ArgName("threads")->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
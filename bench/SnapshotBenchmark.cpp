@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+
+#include "MazeSnapshot.h"
+#include "Fixtures.h"
+
+namespace
+{
+    constexpr size_t kMazeSize = 4096;
+
+    const std::filesystem::path& snapshotPath()
+    {
+        static const std::filesystem::path path = [] {
+            std::filesystem::path p = std::filesystem::temp_directory_path() / "labyrinth_bench.snap";
+            MazeSnapshot::Save(fixtures::sharedMaze(kMazeSize), p);
+            return p;
+        }();
+        return path;
+    }
+}
+
+// Compare against BM_UpdateMaze/4096 - the cost of generating the same maze from scratch
+static void BM_Snapshot_Load(benchmark::State& state)
+{
+    const bool verify = state.range(0) != 0;
+    const std::filesystem::path& path = snapshotPath();
+
+    for (auto _ : state)
+    {
+        std::shared_ptr<Maze> maze = MazeSnapshot::Load(path, verify);
+        benchmark::DoNotOptimize(maze->cell(kMazeSize - 1, kMazeSize - 1));
+    }
+    state.SetItemsProcessed(state.iterations() * kMazeSize * kMazeSize);
+}
+BENCHMARK(BM_Snapshot_Load)->ArgName("verify")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_Snapshot_Save(benchmark::State& state)
+{
+    const Maze& maze = fixtures::sharedMaze(kMazeSize);
+    const std::filesystem::path& path = snapshotPath();
+
+    for (auto _ : state)
+    {
+        MazeSnapshot::Save(maze, path);
+    }
+    state.SetBytesProcessed(state.iterations() * maze.getGrid().size());
+}
+BENCHMARK(BM_Snapshot_Save)->Unit(benchmark::kMillisecond);
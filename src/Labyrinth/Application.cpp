@@ -19,10 +19,11 @@ static void waitForEnter()
     std::cin.get();
 }
 
-Application::Application(std::shared_ptr<MazeFactory> factory, size_t Height, size_t Width, uint32_t seed)
+Application::Application(std::shared_ptr<MazeFactory> factory, size_t Height, size_t Width, uint32_t seed, std::shared_ptr<ThreadPool> pool)
     : m_maze(factory->createMaze(Width, Height, seed))
     , m_pathfinder(std::make_shared<Pathfinder>(m_maze))
-    , m_battle(m_maze)
+    , m_pathCache(m_pathfinder, m_maze)
+    , m_battle(m_maze, std::move(pool))
 {
     std::cout << "Aplication start" << std::endl;
 }
@@ -32,11 +33,12 @@ Application* Application::GetInstance()
     return s_instance;
 }
 
-void Application::Init(std::shared_ptr<MazeFactory> factory, size_t Height, size_t Width, uint32_t seed)
+void Application::Init(std::shared_ptr<MazeFactory> factory, size_t Height, size_t Width, uint32_t seed,
+    std::shared_ptr<ThreadPool> pool)
 {
     if (!s_instance)
     {
-        s_instance = new Application(factory,Height,Width,seed);
+        s_instance = new Application(factory,Height,Width,seed,std::move(pool));
     }
 }
 
@@ -50,7 +52,7 @@ void Application::Run()
     bool stopped = false;
     while(!stopped)
     {
-        CLEAR_SCREEN();
+        TerminalRenderer::ClearScreen();
         std::cout << "Enter the opcode!\n";
         std::cout << "0 - Start battle\n";
         std::cout << "1 - Print maze\n";
@@ -101,8 +103,9 @@ void Application::Run()
                 break;
             }
             std::cout << "Path:\n";
-            std::vector<Vec2i> path = m_pathfinder->invoke(start, end, Vec2i::Manhattan);
+            const std::vector<Vec2i>& path = m_pathCache.invoke(start, end);
             MazePrinter::PrintInConsole(m_maze.get(), path);
+            std::cout << "[LOG]: Path cache hit rate - " << m_pathCache.getHitRate() * 100.0 << "%." << std::endl;
             waitForEnter();
         }; break;
         default: // Exit
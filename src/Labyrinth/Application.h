@@ -2,6 +2,7 @@
 
 #include "Battle.h"
 #include "Pathfinding.h"
+#include "PathCache.h"
 
 class Application 
 {
@@ -18,17 +19,19 @@ public:
 
     static Application* GetInstance();
 
-    static void Init(std::shared_ptr<MazeFactory> factory,size_t Height, size_t Width, uint32_t seed = 0);
+    static void Init(std::shared_ptr<MazeFactory> factory,size_t Height, size_t Width, uint32_t seed = 0,
+        std::shared_ptr<ThreadPool> pool = nullptr);
     static void Deinit();
 
     void Run();
 
 protected:
-    Application(std::shared_ptr<MazeFactory> factory, size_t Height, size_t Width, uint32_t seed = 0);
+    Application(std::shared_ptr<MazeFactory> factory, size_t Height, size_t Width, uint32_t seed, std::shared_ptr<ThreadPool> pool);
 
 private:
     std::shared_ptr<Maze> m_maze;
     std::shared_ptr<Pathfinder> m_pathfinder;
+    PathCache m_pathCache;
     BattleContext m_battle;
 private:
     static inline Application* s_instance = nullptr;
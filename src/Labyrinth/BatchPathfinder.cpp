@@ -0,0 +1,66 @@
+#include "BatchPathfinder.h"
+
+#include <algorithm>
+
+BatchPathfinder::BatchPathfinder(const std::shared_ptr<Maze>& maze, std::shared_ptr<ThreadPool> pool)
+    : m_pool(pool ? std::move(pool) : std::make_shared<ThreadPool>())
+{
+    m_finders.reserve(m_pool->getThreadCount());
+    for (size_t i = 0; i < m_pool->getThreadCount(); i++)
+        m_finders.emplace_back(maze);
+}
+
+PathBatch BatchPathfinder::solve(std::span<const PathQuery> queries)
+{
+    PathBatch batch;
+    solve(queries, batch);
+    return batch;
+}
+
+void BatchPathfinder::solve(std::span<const PathQuery> queries, PathBatch& out)
+{
+    const size_t blockCount = (queries.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    if (m_blocks.size() < blockCount)
+        m_blocks.resize(blockCount);
+
+    m_pool->parallelFor(blockCount, [&](size_t block, size_t thread)
+    {
+        Pathfinder& finder = m_finders[thread];
+        Block& result = m_blocks[block];
+        result.steps.clear();
+        result.lengths.clear();
+        result.expanded = 0;
+
+        const size_t end = std::min(queries.size(), (block + 1) * BLOCK_SIZE);
+        for (size_t i = block * BLOCK_SIZE; i < end; i++)
+        {
+            result.lengths.push_back(static_cast<uint32_t>(finder.findInto(queries[i].start, queries[i].goal, result.steps)));
+            result.expanded += finder.getExpandedCount();
+        }
+    });
+
+    // prefix sums give every block its place in the output, the copies themselves are independent
+    out.offsets.resize(queries.size() + 1);
+    out.offsets[0] = 0;
+    out.expanded = 0;
+    std::vector<size_t> blockStart(blockCount + 1, 0);
+    for (size_t block = 0; block < blockCount; block++)
+    {
+        blockStart[block + 1] = blockStart[block] + m_blocks[block].steps.size();
+        out.expanded += m_blocks[block].expanded;
+    }
+    out.steps.resize(blockStart[blockCount]);
+
+    m_pool->parallelFor(blockCount, [&](size_t block)
+    {
+        const Block& result = m_blocks[block];
+        std::copy(result.steps.begin(), result.steps.end(), out.steps.begin() + blockStart[block]);
+
+        uint32_t offset = static_cast<uint32_t>(blockStart[block]);
+        for (size_t i = 0; i < result.lengths.size(); i++)
+        {
+            offset += result.lengths[i];
+            out.offsets[block * BLOCK_SIZE + i + 1] = offset;
+        }
+    });
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "Pathfinding.h"
+#include "utility/ThreadPool.h"
+
+struct PathQuery
+{
+    Vec2i start;
+    Vec2i goal;
+};
+
+/**
+ * @brief Paths of a batch packed back to back: path i is steps[offsets[i], offsets[i + 1])
+ */
+struct PathBatch
+{
+    std::vector<uint32_t> offsets;
+    std::vector<Vec2i> steps;
+    // nodes expanded over the whole batch
+    size_t expanded = 0;
+
+    inline size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    // same shape as Pathfinder::find - start excluded, goal included, empty if unreachable
+    inline std::span<const Vec2i> operator[](size_t i) const { return { steps.data() + offsets[i], steps.data() + offsets[i + 1] }; }
+};
+
+/**
+ * @brief Solves many (start, goal) queries at once on a thread pool
+ *
+ * Each pool thread owns a Pathfinder, and with it a search workspace, so queries never share mutable
+ * state. Queries are handed out in contiguous blocks; every block collects its paths in its own buffer
+ * and the buffers are then copied, in query order, into the single output buffer. The result therefore
+ * does not depend on the thread count.
+ */
+class BatchPathfinder
+{
+public:
+    static constexpr size_t BLOCK_SIZE = 64;
+
+public:
+    // pool == nullptr creates one of hardware_concurrency() threads
+    BatchPathfinder(const std::shared_ptr<Maze>& maze, std::shared_ptr<ThreadPool> pool = nullptr);
+    ~BatchPathfinder() = default;
+
+    PathBatch solve(std::span<const PathQuery> queries);
+    // reuses the capacity of out from an earlier batch
+    void solve(std::span<const PathQuery> queries, PathBatch& out);
+
+    // per-thread finders, e.g. to switch all of them to another SearchMode
+    inline std::vector<Pathfinder>& getPathfinders() { return m_finders; }
+    inline ThreadPool& getThreadPool() const { return *m_pool; }
+
+private:
+    struct Block
+    {
+        std::vector<Vec2i> steps;
+        std::vector<uint32_t> lengths;
+        size_t expanded = 0;
+    };
+
+private:
+    std::shared_ptr<ThreadPool> m_pool;
+    std::vector<Pathfinder> m_finders;
+    std::vector<Block> m_blocks;
+};
@@ -17,49 +17,70 @@ static void waitForInput(BattleContext* context)
     context->Close();
 }
 
+bool BattleContext::tick(RobotManager::StepCounts& steps)
+{
+    m_robotManager.Tick(steps);
+    const bool arrived = m_robotManager.GetArrivedCount() == m_robotManager.GetRobotCount();
+
+    if(m_maze->getVersion() != m_seenVersion)
+    {
+        m_robotManager.UpdatePaths();
+        m_seenVersion = m_maze->getVersion();
+    }
+    return arrived;
+}
+
+BattleReport BattleContext::RunHeadless(size_t maxTicks)
+{
+    const bool logging = m_robotManager.IsLogging();
+    m_robotManager.SetLogging(false);
+
+    BattleReport report;
+    const auto begin = std::chrono::steady_clock::now();
+    while (!report.finished && (maxTicks == 0 || report.ticks < maxTicks))
+    {
+        report.finished = tick(report.steps);
+        ++report.ticks;
+    }
+    report.wallTime = std::chrono::steady_clock::now() - begin;
+
+    m_robotManager.SetLogging(logging);
+    return report;
+}
+
+void BattleReport::print(std::ostream& os) const
+{
+    os << "[LOG]: Battle " << (finished ? "finished" : "stopped") << " after " << ticks << " ticks." << std::endl;
+    os << "[LOG]: Wall time - " << wallTime.count() * 1000.0 << " ms, " << getTicksPerSecond() << " ticks/s." << std::endl;
+    os << "[LOG]: AngryRobot steps - " << steps[static_cast<size_t>(Robots::ANGRY)] << "." << std::endl;
+    os << "[LOG]: BoomRobot steps - " << steps[static_cast<size_t>(Robots::BOOM)] << "." << std::endl;
+    os << "[LOG]: SimpleRobot steps - " << steps[static_cast<size_t>(Robots::SIMPLE)] << "." << std::endl;
+    os << "[LOG]: SlowRobot steps - " << steps[static_cast<size_t>(Robots::SLOW)] << "." << std::endl;
+}
+
 void BattleContext::Run()
 {
     using namespace std::chrono_literals;
     
-    std::array<size_t, static_cast<size_t>(Robots::UNKNOWN)> steps;
+    RobotManager::StepCounts steps;
     steps.fill(-1);
 
+    // redraws only what changed since the previous tick, [LOG] lines go below the maze
+    TerminalRenderer renderer;
+
     std::future inputFuture = std::async(std::launch::async, waitForInput, this);
 
     while (!ShouldClose())
     {
-        std::cout << "[LOG]: Battle continues!\n";
         std::this_thread::sleep_for(300ms);
-        CLEAR_SCREEN();
-
-        Vec2i goal = m_robotManager.GetRobots()[0]->getGoal();
-        MazePrinter::PrintInConsoleRobots(m_maze.get(), m_robotManager.GetRobots(), goal);
+        renderer.render(m_maze, m_robotManager);
+        std::cout << "[LOG]: Battle continues!\n";
 
-        size_t arrived = 0;
-        for (IRobot* robot : m_robotManager.GetRobots())
-        {
-            robot->move();
-            if (robot->isArrived())
-            {
-                ++arrived;
-                continue;
-            }
-            ++steps[static_cast<size_t>(robot->getRobotType())];
-        }
-        if (arrived == steps.size())
+        if (tick(steps))
         {
             std::cout << "[LOG]: All robots arrived to goal!\n";
             Close();
         }
-
-        if(m_maze->getUpdateState())
-        {
-            for (IRobot* robot : m_robotManager.GetRobots())
-            {
-                robot->UpdatePath();
-            }
-            m_maze->handleUpdate();
-        }
     }
 
     std::cout << "[LOG]: Battle ended!\n";
@@ -85,6 +106,6 @@ void BattleContext::Run()
         std::cin >> c;
     }
 
-    CLEAR_SCREEN();
+    TerminalRenderer::ClearScreen();
     Reset();
 }
\ No newline at end of file
@@ -4,29 +4,51 @@
 #include <vector>
 #include <memory>
 #include <limits>
+#include <chrono>
+#include <ostream>
 
 #include "Maze.h"
 #include "Robot.h"
+#include "TerminalRenderer.h"
+#include "utility/ThreadPool.h"
 
-#if defined(_WIN32) || defined(WIN32)
-    #define CLEAR_SCREEN() system("cls")
-#else
-    #define CLEAR_SCREEN() system("clear")
-#endif
+/**
+ * @brief Outcome of a headless battle
+ */
+struct BattleReport
+{
+    size_t ticks = 0;
+    // steps taken per Robots type while the robot was still on its way
+    RobotManager::StepCounts steps{};
+    std::chrono::duration<double> wallTime{};
+    // every robot arrived (or got stuck) before the tick limit
+    bool finished = false;
+
+    inline double getTicksPerSecond() const { return wallTime.count() > 0.0 ? ticks / wallTime.count() : 0.0; }
+    void print(std::ostream& os) const;
+};
 
 class BattleContext
 {
 public:
-    BattleContext(const std::shared_ptr<Maze>& maze)
+    // pool - optional, spreads the planning phase of every tick over its threads
+    BattleContext(const std::shared_ptr<Maze>& maze, std::shared_ptr<ThreadPool> pool = nullptr)
         : m_maze(maze)
         , m_closed(false)
-        , m_robotManager(maze, std::make_shared<Pathfinder>(maze))
+        , m_robotManager(maze, std::move(pool))
     {
     }
     ~BattleContext() = default;
 
     void Reset();
     void Run(); 
+    /**
+     * @brief Runs the battle at full speed: no sleeping, drawing or [LOG] lines
+     *
+     * Stops once every robot arrived or after maxTicks ticks (0 - no limit). The robots and the maze are
+     * left as the battle ended, call Reset() before running again.
+     */
+    BattleReport RunHeadless(size_t maxTicks = 0);
 
     inline constexpr bool ShouldClose() const { return m_closed; }
     inline void Close() { m_closed = true; }
@@ -34,8 +56,14 @@ public:
     inline constexpr RobotManager& GetRobotManager() { return m_robotManager; }
     inline constexpr const RobotManager& GetRobotManager() const { return m_robotManager; }
 
+private:
+    // moves every robot once and replans if the maze changed, true once all robots arrived
+    bool tick(RobotManager::StepCounts& steps);
+
 private:
     std::shared_ptr<Maze> m_maze;
+    // maze version the robots last replanned for
+    uint64_t m_seenVersion = UINT64_MAX;
     bool m_closed;
     RobotManager m_robotManager;
 }; // Game class
\ No newline at end of file
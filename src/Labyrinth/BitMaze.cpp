@@ -0,0 +1,122 @@
+#include "BitMaze.h"
+
+BitMaze::BitMaze(size_t width, size_t height)
+    : m_width(width)
+    , m_height(height)
+    , m_wordsPerRow((width + WORD_BITS - 1) / WORD_BITS)
+    , m_east(m_wordsPerRow * height, 0)
+    , m_south(m_wordsPerRow * height, 0)
+{
+}
+
+BitMaze::BitMaze(const Maze& maze)
+    : BitMaze(maze.getWidth(), maze.getHeight())
+{
+    for (size_t y = 0; y < m_height; y++)
+    {
+        for (size_t x = 0; x < m_width; x++)
+        {
+            const Cell& cell = maze.cell(x, y);
+            if (cell.hasPath(Direction::EAST))
+                m_east[wordIndex(x, y)] |= bit(x);
+            if (cell.hasPath(Direction::SOUTH))
+                m_south[wordIndex(x, y)] |= bit(x);
+        }
+    }
+}
+
+bool BitMaze::hasPath(size_t x, size_t y, Direction dir) const
+{
+    switch (dir)
+    {
+    case Direction::EAST:
+        return m_east[wordIndex(x, y)] & bit(x);
+    case Direction::SOUTH:
+        return m_south[wordIndex(x, y)] & bit(x);
+    // west and north walls belong to the neighboring cell
+    case Direction::WEST:
+        return x > 0 && (m_east[wordIndex(x - 1, y)] & bit(x - 1));
+    case Direction::NORTH:
+        return y > 0 && (m_south[wordIndex(x, y - 1)] & bit(x));
+    default:
+        return false;
+    }
+}
+
+uint8_t BitMaze::getValue(size_t x, size_t y) const
+{
+    uint8_t value = 0;
+    for (Direction dir : { Direction::NORTH, Direction::EAST, Direction::SOUTH, Direction::WEST })
+    {
+        if (hasPath(x, y, dir))
+            value |= static_cast<uint8_t>(dir);
+    }
+    return value;
+}
+
+bool BitMaze::breakWall(const Vec2i& pos, const Vec2i& delta)
+{
+    Vec2i npos = pos + delta;
+    if (npos.x < 0 || npos.y < 0 ||
+        npos.x >= static_cast<int32_t>(m_width) || npos.y >= static_cast<int32_t>(m_height))
+    {
+        return false;
+    }
+
+    // the wall is stored in whichever of the two cells is west/north of the other
+    Direction dir = (Direction) delta;
+    bool horizontal = dir == Direction::EAST || dir == Direction::WEST;
+    Vec2i owner = (dir == Direction::EAST || dir == Direction::SOUTH) ? pos : npos;
+    word_type& word = horizontal ? m_east[wordIndex(owner.x, owner.y)] : m_south[wordIndex(owner.x, owner.y)];
+
+    if (word & bit(owner.x))
+    {
+        return false;
+    }
+    word |= bit(owner.x);
+    return true;
+}
+
+BitMaze::word_type BitMaze::passageWord(size_t y, size_t word, Direction dir) const
+{
+    const size_t idx = y * m_wordsPerRow + word;
+    switch (dir)
+    {
+    case Direction::EAST:
+        return m_east[idx];
+    case Direction::SOUTH:
+        return m_south[idx];
+    case Direction::WEST:
+        // cell i is open to the west when cell i - 1 is open to the east, carrying across word boundaries
+        return (m_east[idx] << 1) | (word > 0 ? m_east[idx - 1] >> (WORD_BITS - 1) : 0);
+    case Direction::NORTH:
+        return y > 0 ? m_south[idx - m_wordsPerRow] : 0;
+    default:
+        return 0;
+    }
+}
+
+BitMaze::word_type BitMaze::validMask(size_t word) const
+{
+    const size_t tail = m_width - word * WORD_BITS;
+    return tail >= WORD_BITS ? ~word_type(0) : (word_type(1) << tail) - 1;
+}
+
+void BitMaze::copyTo(Grid& grid) const
+{
+    for (size_t y = 0; y < m_height; y++)
+    {
+        for (size_t x = 0; x < m_width; x++)
+        {
+            Cell cell;
+            uint8_t value = getValue(x, y);
+            for (Direction dir : { Direction::NORTH, Direction::EAST, Direction::SOUTH, Direction::WEST })
+            {
+                if (value & static_cast<uint8_t>(dir))
+                    cell.breakWall(dir);
+            }
+            cell.setVisited();
+            grid.cell(x, y) = cell;
+        }
+    }
+}
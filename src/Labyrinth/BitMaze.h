@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Maze.h"
+
+/**
+ * @brief Compact maze backend, stores only "east open" and "south open" passages as packed 64-bit bitplanes
+ *
+ * Each wall is owned by exactly one cell (the one to its west or north), so a maze costs 2 bits per cell
+ * instead of the 8 bits of a Cell grid, and breaking a wall is a single bit write.
+ * Bit i of word w in row y describes the cell (w * 64 + i, y); bits past the width are always zero.
+ */
+class BitMaze
+{
+public:
+    using word_type = uint64_t;
+    static constexpr size_t WORD_BITS = 64;
+
+public:
+    BitMaze(size_t width, size_t height);
+    explicit BitMaze(const Maze& maze);
+    ~BitMaze() = default;
+
+    inline constexpr size_t getWidth() const { return m_width; }
+    inline constexpr size_t getHeight() const { return m_height; }
+    inline constexpr size_t getWordsPerRow() const { return m_wordsPerRow; }
+
+    bool hasPath(size_t x, size_t y, Direction dir) const;
+    // 4-bit passage mask in the same encoding as Cell::getValue()
+    uint8_t getValue(size_t x, size_t y) const;
+
+    // same contract as Maze::breakWall, but only one bit gets written
+    bool breakWall(const Vec2i& pos, const Vec2i& delta);
+
+    /**
+     * @brief Word-parallel passage query
+     * 
+     * @return word whose bit i is set if the cell (word * 64 + i, y) has a passage in direction dir
+     */
+    word_type passageWord(size_t y, size_t word, Direction dir) const;
+
+    // raw bitplane rows for bulk readers, getWordsPerRow() words each
+    inline const word_type* eastRow(size_t y) const { return &m_east[y * m_wordsPerRow]; }
+    inline const word_type* southRow(size_t y) const { return &m_south[y * m_wordsPerRow]; }
+    inline word_type* eastRow(size_t y) { return &m_east[y * m_wordsPerRow]; }
+    inline word_type* southRow(size_t y) { return &m_south[y * m_wordsPerRow]; }
+
+    // mask of the bits of a row word that address real cells
+    word_type validMask(size_t word) const;
+
+    // expands the bitplanes back into a Cell grid, e.g. for printing
+    void copyTo(Grid& grid) const;
+
+private:
+    inline constexpr size_t wordIndex(size_t x, size_t y) const { return y * m_wordsPerRow + x / WORD_BITS; }
+    static inline constexpr word_type bit(size_t x) { return word_type(1) << (x % WORD_BITS); }
+
+private:
+    size_t m_width;
+    size_t m_height;
+    size_t m_wordsPerRow;
+    std::vector<word_type> m_east;
+    std::vector<word_type> m_south;
+};
@@ -0,0 +1,150 @@
+#include "DStarLite.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "Pathfinding.h"
+
+DStarLite::DStarLite(const std::shared_ptr<Maze>& maze, const Vec2i& goal)
+    : m_maze(maze)
+    , m_goal(goal)
+    , m_start(goal)
+    , m_last(goal)
+    , m_width(maze->getWidth())
+    , m_cursor(maze->getJournal())
+{
+}
+
+void DStarLite::initialize()
+{
+    const size_t size = m_maze->getWidth() * m_maze->getHeight();
+    m_g.assign(size, INF);
+    m_rhs.assign(size, INF);
+    m_open.clear();
+    m_keyModifier = 0;
+    m_last = m_start;
+
+    m_rhs[toIndex1D(m_goal)] = 0;
+    push(toIndex1D(m_goal));
+}
+
+uint64_t DStarLite::calculateKey(uint32_t index) const
+{
+    const uint32_t k2 = std::min(m_g[index], m_rhs[index]);
+    // an unreached vertex must sort last, adding to INF would wrap around and end the search early
+    const uint32_t k1 = k2 == INF ? INF : k2 + Vec2i::Manhattan(m_start, toPos(index)) + m_keyModifier;
+    return (static_cast<uint64_t>(k1) << 32) | k2;
+}
+
+void DStarLite::push(uint32_t index)
+{
+    m_open.push_back({ calculateKey(index), index });
+    std::push_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+}
+
+void DStarLite::updateVertex(uint32_t index)
+{
+    if (index != toIndex1D(m_goal))
+    {
+        const Vec2i pos = toPos(index);
+        uint32_t rhs = INF;
+        OpenMaskNeighbors::forEach(m_maze->cell(pos.x, pos.y), pos, [&](const Vec2i& neighborPos)
+        {
+            const uint32_t g = m_g[toIndex1D(neighborPos)];
+            if (g != INF)
+                rhs = std::min(rhs, g + 1);
+        });
+        m_rhs[index] = rhs;
+    }
+    // an inconsistent vertex belongs in the open list, older entries for it go stale
+    if (m_g[index] != m_rhs[index])
+        push(index);
+}
+
+void DStarLite::computeShortestPath()
+{
+    const uint32_t start = toIndex1D(m_start);
+    while (!m_open.empty() && (m_open.front().key < calculateKey(start) || m_rhs[start] != m_g[start]))
+    {
+        const Entry top = m_open.front();
+        std::pop_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+        m_open.pop_back();
+
+        const uint32_t index = top.index;
+        if (m_g[index] == m_rhs[index])
+            continue; // consistent by now, the entry is stale
+
+        const uint64_t key = calculateKey(index);
+        if (top.key < key)
+        {
+            // start moved since the entry was pushed
+            m_open.push_back({ key, index });
+            std::push_heap(m_open.begin(), m_open.end(), std::greater<Entry>());
+            continue;
+        }
+
+        ++m_expanded;
+        const Vec2i pos = toPos(index);
+        if (m_g[index] > m_rhs[index])
+        {
+            m_g[index] = m_rhs[index];
+        }
+        else
+        {
+            m_g[index] = INF;
+            updateVertex(index);
+        }
+        OpenMaskNeighbors::forEach(m_maze->cell(pos.x, pos.y), pos, [&](const Vec2i& neighborPos)
+        {
+            updateVertex(toIndex1D(neighborPos));
+        });
+    }
+}
+
+void DStarLite::replan(const Vec2i& start, PackedPath& path)
+{
+    m_expanded = 0;
+    m_keyModifier += Vec2i::Manhattan(m_last, start);
+    m_last = start;
+    m_start = start;
+
+    if (const auto changes = m_cursor.pending())
+    {
+        // only opened walls: each edge's endpoints may get a shorter rhs through the new passage
+        for (const MazeChange& change : *changes)
+        {
+            updateVertex(toIndex1D(change.pos));
+            updateVertex(toIndex1D(change.pos + change.delta));
+        }
+    }
+    else
+    {
+        initialize();
+    }
+    m_cursor.advance();
+    computeShortestPath();
+
+    path.clear(start);
+    if (m_g[toIndex1D(start)] == INF)
+        return;
+
+    path.resize(m_g[toIndex1D(start)]);
+    size_t i = 0;
+    for (Vec2i pos = start; pos != m_goal; )
+    {
+        // descend the distance field, ties broken in N, E, S, W order
+        uint32_t best = INF;
+        Vec2i next = pos;
+        OpenMaskNeighbors::forEach(m_maze->cell(pos.x, pos.y), pos, [&](const Vec2i& neighborPos)
+        {
+            const uint32_t g = m_g[toIndex1D(neighborPos)];
+            if (g < best)
+            {
+                best = g;
+                next = neighborPos;
+            }
+        });
+        path.set(i++, PackedPath::CodeOf(pos, next));
+        pos = next;
+    }
+}
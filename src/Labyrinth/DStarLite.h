@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Maze.h"
+#include "PackedPath.h"
+
+/**
+ * @brief D* Lite incremental planner towards one fixed goal
+ *
+ * The search runs backwards from the goal and keeps its g/rhs values between queries. When walls break,
+ * replan() reads the opened edges from the maze journal and only re-expands the vertices whose
+ * distance to the goal actually changed, so the cost follows the size of the change rather than the size
+ * of the maze; the robot moving in between is absorbed by the key modifier instead of a restart.
+ * A regenerated maze (Maze::UpdateMaze) cannot be replayed and starts the search over.
+ *
+ * Costs 8 bytes per maze cell, kept for the planner's lifetime.
+ */
+class DStarLite
+{
+public:
+    DStarLite(const std::shared_ptr<Maze>& maze, const Vec2i& goal);
+    ~DStarLite() = default;
+
+    /**
+     * @brief Catches up with the maze and returns the shortest path from start
+     *
+     * Same shape as Pathfinder::find - start excluded, goal included, empty if unreachable - written
+     * into path as packed steps, which keeps its capacity between replans.
+     */
+    void replan(const Vec2i& start, PackedPath& path);
+
+    inline constexpr const Vec2i& getGoal() const { return m_goal; }
+    // vertices expanded by the last replan()
+    inline constexpr size_t getExpandedCount() const { return m_expanded; }
+
+private:
+    static constexpr uint32_t INF = UINT32_MAX;
+
+    struct Entry
+    {
+        uint64_t key; // (k1 << 32) | k2 compares like the [k1; k2] pair
+        uint32_t index;
+
+        inline bool operator>(const Entry& rhs) const { return key > rhs.key; }
+    };
+
+    void initialize();
+    void computeShortestPath();
+    void updateVertex(uint32_t index);
+    uint64_t calculateKey(uint32_t index) const;
+    void push(uint32_t index);
+
+    inline constexpr uint32_t toIndex1D(const Vec2i& pos) const { return static_cast<uint32_t>(pos.y * m_width + pos.x); }
+    inline constexpr Vec2i toPos(uint32_t index) const { return Vec2i(index % m_width, index / m_width); }
+
+private:
+    std::shared_ptr<Maze> m_maze;
+    Vec2i m_goal;
+    Vec2i m_start;
+    Vec2i m_last;
+    size_t m_width;
+    uint32_t m_keyModifier = 0;
+    // position in the maze journal the g/rhs values describe, unsynced before the first search
+    MazeJournal::Cursor m_cursor;
+    size_t m_expanded = 0;
+
+    std::vector<uint32_t> m_g;
+    std::vector<uint32_t> m_rhs;
+    // lazy-deletion heap: outdated entries are recognized and dropped when they surface
+    std::vector<Entry> m_open;
+};
@@ -0,0 +1,122 @@
+#include "DistanceField.h"
+
+#include <algorithm>
+
+#include "Pathfinding.h"
+
+DistanceField::DistanceField(const std::shared_ptr<Maze>& maze, const Vec2i& goal)
+    : m_maze(maze)
+    , m_goal(goal)
+    , m_width(maze->getWidth())
+    , m_cursor(maze->getJournal())
+{
+    update();
+}
+
+void DistanceField::update()
+{
+    m_updated = 0;
+    if (m_cursor.isCurrent())
+        return;
+
+    if (const auto changes = m_cursor.pending())
+    {
+        m_queue.clear();
+        for (const MazeChange& change : *changes)
+        {
+            // the new passage can shorten whichever endpoint was further away
+            const uint32_t lhs = toIndex1D(change.pos);
+            const uint32_t rhs = toIndex1D(change.pos + change.delta);
+            if (m_distances[lhs] != UNREACHABLE)
+                lower(rhs, m_distances[lhs] + 1);
+            if (m_distances[rhs] != UNREACHABLE)
+                lower(lhs, m_distances[rhs] + 1);
+        }
+        propagate();
+    }
+    else
+    {
+        rebuild();
+    }
+    // only now, advancing may compact the entries just read
+    m_cursor.advance();
+}
+
+void DistanceField::rebuild()
+{
+    m_distances.assign(m_maze->getWidth() * m_maze->getHeight(), UNREACHABLE);
+    m_queue.clear();
+    m_updated = 0;
+    lower(toIndex1D(m_goal), 0);
+    propagate();
+}
+
+void DistanceField::lower(uint32_t index, uint32_t distance)
+{
+    if (distance >= m_distances[index])
+        return;
+    m_distances[index] = distance;
+    m_queue.push_back(index);
+    ++m_updated;
+}
+
+void DistanceField::propagate()
+{
+    // seeds of an incremental update sit at different depths, so a cell may be lowered more than once
+    for (size_t head = 0; head < m_queue.size(); head++)
+    {
+        const uint32_t index = m_queue[head];
+        const uint32_t distance = m_distances[index] + 1;
+        const Vec2i pos = toPos(index);
+        OpenMaskNeighbors::forEach(m_maze->cell(pos.x, pos.y), pos, [&](const Vec2i& neighborPos)
+        {
+            lower(toIndex1D(neighborPos), distance);
+        });
+    }
+    m_queue.clear();
+}
+
+Vec2i DistanceField::nextStep(const Vec2i& pos) const
+{
+    const uint32_t distance = m_distances[toIndex1D(pos)];
+    if (distance == 0 || distance == UNREACHABLE)
+        return pos;
+
+    // first downhill neighbor in N, E, S, W order
+    const OpenMaskNeighbors::Entry& entry = OpenMaskNeighbors::TABLE[m_maze->cell(pos.x, pos.y).getValue()];
+    for (uint8_t i = 0; i < entry.count; i++)
+    {
+        const Vec2i& delta = OpenMaskNeighbors::DELTAS[entry.directions[i]];
+        const Vec2i neighbor(pos.x + delta.x, pos.y + delta.y);
+        if (m_distances[toIndex1D(neighbor)] == distance - 1)
+            return neighbor;
+    }
+    return pos;
+}
+
+std::vector<Vec2i> DistanceField::path(const Vec2i& start) const
+{
+    std::vector<Vec2i> path;
+    if (distance(start) == UNREACHABLE)
+        return path;
+
+    path.reserve(distance(start));
+    for (Vec2i pos = nextStep(start); path.size() < distance(start); pos = nextStep(pos))
+        path.push_back(pos);
+    return path;
+}
+
+std::shared_ptr<DistanceField> GoalFields::get(const Vec2i& goal)
+{
+    auto it = std::find_if(m_fields.begin(), m_fields.end(),
+        [&](const std::shared_ptr<DistanceField>& field) { return field->getGoal() == goal; });
+    if (it != m_fields.end())
+        return *it;
+    return m_fields.emplace_back(std::make_shared<DistanceField>(m_maze, goal));
+}
+
+void GoalFields::update()
+{
+    for (const std::shared_ptr<DistanceField>& field : m_fields)
+        field->update();
+}
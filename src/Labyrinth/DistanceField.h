@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Maze.h"
+
+/**
+ * @brief BFS distance from every cell to one goal, shared by all robots heading there
+ *
+ * A robot follows the field downhill, one neighbor lookup per step, so no robot ever searches.
+ * Broken walls can only shorten distances: update() replays the walls opened since it last ran
+ * from the maze journal and propagates the decrease from their endpoints, touching only cells
+ * that actually got closer. A regenerated maze is flooded again from scratch.
+ */
+class DistanceField
+{
+public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+public:
+    DistanceField(const std::shared_ptr<Maze>& maze, const Vec2i& goal);
+    ~DistanceField() = default;
+
+    // catches up with the maze journal, a no-op if nothing changed
+    void update();
+
+    inline uint32_t distance(const Vec2i& pos) const { return m_distances[toIndex1D(pos)]; }
+    // neighbor one step closer to the goal, pos itself at the goal or if the goal is unreachable
+    Vec2i nextStep(const Vec2i& pos) const;
+    // same shape as Pathfinder::find - start excluded, goal included, empty if unreachable
+    std::vector<Vec2i> path(const Vec2i& start) const;
+
+    inline constexpr const Vec2i& getGoal() const { return m_goal; }
+    // cells whose distance the last update() lowered, or flooded for a rebuild
+    inline constexpr size_t getUpdatedCount() const { return m_updated; }
+
+private:
+    void rebuild();
+    // lowers index to distance if that is shorter and queues it for propagation
+    void lower(uint32_t index, uint32_t distance);
+    void propagate();
+
+    inline constexpr uint32_t toIndex1D(const Vec2i& pos) const { return static_cast<uint32_t>(pos.y * m_width + pos.x); }
+    inline constexpr Vec2i toPos(uint32_t index) const { return Vec2i(index % m_width, index / m_width); }
+
+private:
+    std::shared_ptr<Maze> m_maze;
+    Vec2i m_goal;
+    size_t m_width;
+    MazeJournal::Cursor m_cursor;
+    size_t m_updated = 0;
+
+    std::vector<uint32_t> m_distances;
+    std::vector<uint32_t> m_queue;
+};
+
+/**
+ * @brief One DistanceField per distinct goal, handed out to every robot that asks for that goal
+ */
+class GoalFields
+{
+public:
+    GoalFields(const std::shared_ptr<Maze>& maze)
+        : m_maze(maze)
+    {
+    }
+
+    std::shared_ptr<DistanceField> get(const Vec2i& goal);
+    // brings every field up to date with the maze
+    void update();
+
+private:
+    std::shared_ptr<Maze> m_maze;
+    // a battle has a handful of goals at most, a linear scan beats hashing
+    std::vector<std::shared_ptr<DistanceField>> m_fields;
+};
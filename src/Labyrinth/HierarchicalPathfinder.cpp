@@ -0,0 +1,282 @@
+#include "HierarchicalPathfinder.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "Pathfinding.h"
+
+namespace
+{
+    // abstract node ids besides entrance cell indices
+    constexpr uint32_t START_NODE = UINT32_MAX - 1;
+    constexpr uint32_t GOAL_NODE = UINT32_MAX;
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(const std::shared_ptr<Maze>& maze, size_t clusterSize, std::shared_ptr<ThreadPool> pool)
+    : m_maze(maze)
+    , m_pool(std::move(pool))
+    , m_clusterSize(clusterSize)
+    , m_clustersPerRow((maze->getWidth() + clusterSize - 1) / clusterSize)
+    , m_width(maze->getWidth())
+    , m_cursor(maze->getJournal())
+{
+    const size_t clusterRows = (maze->getHeight() + clusterSize - 1) / clusterSize;
+    m_clusters.resize(m_clustersPerRow * clusterRows);
+    for (size_t i = 0; i < m_clusters.size(); i++)
+    {
+        const size_t x0 = (i % m_clustersPerRow) * clusterSize;
+        const size_t y0 = (i / m_clustersPerRow) * clusterSize;
+        m_clusters[i].region = { x0, y0, std::min(x0 + clusterSize, maze->getWidth()), std::min(y0 + clusterSize, maze->getHeight()) };
+    }
+    update();
+}
+
+void HierarchicalPathfinder::LocalSearch::flood(const Maze& maze, const GridRegion& region, size_t clusterSize, const Vec2i& from)
+{
+    const auto toLocal = [&](const Vec2i& pos) { return static_cast<uint32_t>((pos.y - region.y0) * clusterSize + (pos.x - region.x0)); };
+
+    distances.assign(clusterSize * clusterSize, UINT32_MAX);
+    parents.resize(clusterSize * clusterSize);
+    queue.clear();
+
+    const uint32_t root = toLocal(from);
+    distances[root] = 0;
+    parents[root] = root;
+    queue.push_back(root);
+
+    for (size_t head = 0; head < queue.size(); head++)
+    {
+        const uint32_t local = queue[head];
+        const Vec2i pos(region.x0 + local % clusterSize, region.y0 + local / clusterSize);
+        OpenMaskNeighbors::forEach(maze.cell(pos.x, pos.y), pos, [&](const Vec2i& neighborPos)
+        {
+            if (!region.contains(neighborPos.x, neighborPos.y))
+                return;
+            const uint32_t neighbor = toLocal(neighborPos);
+            if (distances[neighbor] != UINT32_MAX)
+                return;
+            distances[neighbor] = distances[local] + 1;
+            parents[neighbor] = local;
+            queue.push_back(neighbor);
+        });
+    }
+}
+
+void HierarchicalPathfinder::update()
+{
+    if (m_cursor.isCurrent())
+        return;
+
+    if (const auto changes = m_cursor.pending())
+    {
+        for (const MazeChange& change : *changes)
+            repair(change.pos, change.delta);
+    }
+    else
+    {
+        build();
+    }
+    m_cursor.advance();
+}
+
+void HierarchicalPathfinder::build()
+{
+    if (m_pool)
+    {
+        m_pool->parallelFor(m_clusters.size(), [this](size_t cluster)
+        {
+            LocalSearch local;
+            buildCluster(cluster, local);
+        });
+        return;
+    }
+
+    for (size_t cluster = 0; cluster < m_clusters.size(); cluster++)
+        buildCluster(cluster, m_local);
+}
+
+void HierarchicalPathfinder::buildCluster(size_t index, LocalSearch& local)
+{
+    Cluster& cluster = m_clusters[index];
+    const GridRegion& region = cluster.region;
+    cluster.entrances.clear();
+
+    // walk the border ring once, corners included only once
+    const auto visit = [&](size_t x, size_t y)
+    {
+        const Vec2i pos(x, y);
+        bool leavesCluster = false;
+        OpenMaskNeighbors::forEach(m_maze->cell(x, y), pos, [&](const Vec2i& neighborPos)
+        {
+            leavesCluster |= !region.contains(neighborPos.x, neighborPos.y);
+        });
+        if (leavesCluster)
+            cluster.entrances.push_back(toIndex1D(pos));
+    };
+    for (size_t x = region.x0; x < region.x1; x++)
+    {
+        visit(x, region.y0);
+        if (region.y1 - 1 != region.y0)
+            visit(x, region.y1 - 1);
+    }
+    for (size_t y = region.y0 + 1; y + 1 < region.y1; y++)
+    {
+        visit(region.x0, y);
+        if (region.x1 - 1 != region.x0)
+            visit(region.x1 - 1, y);
+    }
+
+    const size_t count = cluster.entrances.size();
+    cluster.distances.assign(count * count, UINT32_MAX);
+    for (size_t i = 0; i < count; i++)
+    {
+        local.flood(*m_maze, region, m_clusterSize, toPos(cluster.entrances[i]));
+        for (size_t j = 0; j < count; j++)
+            cluster.distances[i * count + j] = local.distances[toLocal(region, toPos(cluster.entrances[j]))];
+    }
+}
+
+void HierarchicalPathfinder::repair(const Vec2i& pos, const Vec2i& delta)
+{
+    const Vec2i npos = pos + delta;
+    const size_t first = clusterOf(pos);
+    buildCluster(first, m_local);
+    if (npos.x >= 0 && npos.y >= 0 && npos.x < static_cast<int32_t>(m_maze->getWidth()) && npos.y < static_cast<int32_t>(m_maze->getHeight()) && clusterOf(npos) != first)
+        buildCluster(clusterOf(npos), m_local);
+}
+
+size_t HierarchicalPathfinder::getEntranceCount() const
+{
+    return std::accumulate(m_clusters.begin(), m_clusters.end(), size_t(0),
+        [](size_t sum, const Cluster& cluster) { return sum + cluster.entrances.size(); });
+}
+
+bool HierarchicalPathfinder::appendLocalPath(std::vector<Vec2i>& path, size_t cluster, const Vec2i& from, const Vec2i& to)
+{
+    // flooding from the target makes the parent chain run from -> to
+    const GridRegion& region = m_clusters[cluster].region;
+    m_local.flood(*m_maze, region, m_clusterSize, to);
+
+    uint32_t local = static_cast<uint32_t>(toLocal(region, from));
+    if (m_local.distances[local] == UINT32_MAX)
+        return false;
+
+    while (m_local.distances[local] != 0)
+    {
+        local = m_local.parents[local];
+        path.emplace_back(region.x0 + local % m_clusterSize, region.y0 + local / m_clusterSize);
+    }
+    return true;
+}
+
+std::vector<Vec2i> HierarchicalPathfinder::find(const Vec2i& start, const Vec2i& goal)
+{
+    update();
+
+    m_expanded = 0;
+    std::vector<Vec2i> path;
+    if (start == goal)
+        return path;
+
+    const size_t startCluster = clusterOf(start);
+    const size_t goalCluster = clusterOf(goal);
+    if (startCluster == goalCluster && appendLocalPath(path, startCluster, start, goal))
+        return path;
+
+    // attach the goal: its distance to every entrance of its cluster
+    const Cluster& target = m_clusters[goalCluster];
+    m_local.flood(*m_maze, target.region, m_clusterSize, goal);
+    m_goalDistances.resize(target.entrances.size());
+    for (size_t i = 0; i < target.entrances.size(); i++)
+        m_goalDistances[i] = m_local.distances[toLocal(target.region, toPos(target.entrances[i]))];
+
+    m_records.clear();
+    m_open.clear();
+    const auto relax = [&](uint32_t node, uint32_t g, uint32_t parent)
+    {
+        auto [it, inserted] = m_records.try_emplace(node, Record{ g, parent, false });
+        if (!inserted)
+        {
+            if (it->second.closed || g >= it->second.g)
+                return;
+            it->second.g = g;
+            it->second.parent = parent;
+        }
+        m_open.push(node, g + (node == GOAL_NODE ? 0 : Vec2i::Manhattan(toPos(node), goal)));
+    };
+
+    // attach the start: seed the open list with the entrances it reaches inside its cluster
+    const Cluster& source = m_clusters[startCluster];
+    m_local.flood(*m_maze, source.region, m_clusterSize, start);
+    for (uint32_t entrance : source.entrances)
+    {
+        const uint32_t distance = m_local.distances[toLocal(source.region, toPos(entrance))];
+        if (distance != UINT32_MAX)
+            relax(entrance, distance, START_NODE);
+    }
+
+    bool found = false;
+    while (!m_open.empty())
+    {
+        const uint32_t node = m_open.top();
+        const uint32_t f = m_open.topF();
+        m_open.pop();
+        if (node == GOAL_NODE)
+        {
+            found = true;
+            break;
+        }
+
+        Record& record = m_records[node];
+        const Vec2i pos = toPos(node);
+        if (record.closed || record.g + Vec2i::Manhattan(pos, goal) != f)
+            continue;
+        record.closed = true;
+        ++m_expanded;
+        const uint32_t g = record.g;
+
+        const size_t clusterIndex = clusterOf(pos);
+        const Cluster& cluster = m_clusters[clusterIndex];
+        const size_t count = cluster.entrances.size();
+        const size_t i = std::find(cluster.entrances.begin(), cluster.entrances.end(), node) - cluster.entrances.begin();
+
+        if (clusterIndex == goalCluster && m_goalDistances[i] != UINT32_MAX)
+            relax(GOAL_NODE, g + m_goalDistances[i], node);
+
+        for (size_t j = 0; j < count; j++)
+        {
+            const uint32_t distance = cluster.distances[i * count + j];
+            if (j != i && distance != UINT32_MAX)
+                relax(cluster.entrances[j], g + distance, node);
+        }
+
+        OpenMaskNeighbors::forEach(m_maze->cell(pos.x, pos.y), pos, [&](const Vec2i& neighborPos)
+        {
+            if (!cluster.region.contains(neighborPos.x, neighborPos.y))
+                relax(toIndex1D(neighborPos), g + 1, node);
+        });
+    }
+
+    if (!found)
+        return path;
+
+    // abstract chain goal -> start, then refine each hop in order
+    std::vector<uint32_t> chain;
+    for (uint32_t node = m_records[GOAL_NODE].parent; node != START_NODE; node = m_records[node].parent)
+        chain.push_back(node);
+    std::reverse(chain.begin(), chain.end());
+
+    path.reserve(m_records[GOAL_NODE].g);
+    Vec2i from = start;
+    for (uint32_t node : chain)
+    {
+        const Vec2i to = toPos(node);
+        if (clusterOf(from) == clusterOf(to))
+            appendLocalPath(path, clusterOf(to), from, to);
+        else
+            path.push_back(to); // passage between two clusters
+        from = to;
+    }
+    appendLocalPath(path, goalCluster, from, goal);
+    return path;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Maze.h"
+#include "MazeCarver.h"
+#include "OpenList.h"
+#include "utility/ThreadPool.h"
+
+/**
+ * @brief HPA* - hierarchical pathfinding over square clusters of the maze
+ *
+ * The grid is split into clusters of clusterSize x clusterSize cells. Every border cell with a passage
+ * leading into another cluster is an entrance, and each cluster stores the in-cluster BFS distance
+ * between every pair of its entrances. A query attaches start and goal to the entrances of their
+ * clusters, runs A* over that small abstract graph (intra-cluster edges from the tables, one-step edges
+ * across passages between clusters) and finally refines each abstract edge with a BFS confined to one cluster.
+ *
+ * Paths are optimal on perfect mazes; with cycles they may be slightly longer than A* since in-cluster
+ * routes never leave their cluster. A start and goal that are connected inside one cluster skip the
+ * abstract search altogether.
+ *
+ * The abstraction is built per cluster, so a change stays local: each query first replays the walls
+ * opened since the previous one from the maze journal and rebuilds only the one or two clusters around
+ * each of them. A regenerated maze triggers a full build().
+ */
+class HierarchicalPathfinder
+{
+public:
+    static constexpr size_t DEFAULT_CLUSTER_SIZE = 32;
+
+public:
+    // builds the abstraction right away, on the pool if one is given
+    HierarchicalPathfinder(const std::shared_ptr<Maze>& maze, size_t clusterSize = DEFAULT_CLUSTER_SIZE,
+        std::shared_ptr<ThreadPool> pool = nullptr);
+    ~HierarchicalPathfinder() = default;
+
+    // same shape as Pathfinder::find - start excluded, goal included, empty if unreachable
+    std::vector<Vec2i> find(const Vec2i& start, const Vec2i& goal);
+
+    // rebuilds every cluster
+    void build();
+    // catches up with the maze journal, done implicitly by find()
+    void update();
+
+    inline size_t getClusterCount() const { return m_clusters.size(); }
+    size_t getEntranceCount() const;
+    // abstract nodes expanded by the last query
+    inline size_t getExpandedCount() const { return m_expanded; }
+
+private:
+    struct Cluster
+    {
+        GridRegion region;
+        std::vector<uint32_t> entrances; // 1D cell indices
+        std::vector<uint32_t> distances; // entrances x entrances, UINT32_MAX if not connected inside the cluster
+    };
+
+    // BFS confined to one cluster, parents point back towards the cell it was flooded from
+    struct LocalSearch
+    {
+        std::vector<uint32_t> distances;
+        std::vector<uint32_t> parents;
+        std::vector<uint32_t> queue;
+
+        void flood(const Maze& maze, const GridRegion& region, size_t clusterSize, const Vec2i& from);
+    };
+
+    struct Record
+    {
+        uint32_t g;
+        uint32_t parent;
+        bool closed;
+    };
+
+    void buildCluster(size_t cluster, LocalSearch& local);
+    // rebuilds the clusters on both sides of the wall between pos and pos + delta
+    void repair(const Vec2i& pos, const Vec2i& delta);
+    // appends the in-cluster path from -> to (from excluded), false if there is none
+    bool appendLocalPath(std::vector<Vec2i>& path, size_t cluster, const Vec2i& from, const Vec2i& to);
+
+    inline size_t clusterOf(const Vec2i& pos) const { return (pos.y / m_clusterSize) * m_clustersPerRow + pos.x / m_clusterSize; }
+    inline size_t toLocal(const GridRegion& region, const Vec2i& pos) const { return (pos.y - region.y0) * m_clusterSize + (pos.x - region.x0); }
+    inline constexpr uint32_t toIndex1D(const Vec2i& pos) const { return static_cast<uint32_t>(pos.y * m_width + pos.x); }
+    inline constexpr Vec2i toPos(uint32_t index) const { return Vec2i(index % m_width, index / m_width); }
+
+private:
+    std::shared_ptr<Maze> m_maze;
+    std::shared_ptr<ThreadPool> m_pool;
+    size_t m_clusterSize;
+    size_t m_clustersPerRow;
+    size_t m_width;
+    MazeJournal::Cursor m_cursor;
+    std::vector<Cluster> m_clusters;
+
+    // per-query state, reused between queries
+    LocalSearch m_local;
+    std::vector<uint32_t> m_goalDistances;
+    std::unordered_map<uint32_t, Record> m_records;
+    HeapOpenList m_open;
+    size_t m_expanded = 0;
+};
@@ -1,20 +1,91 @@
 
 #include "Application.h"
 #include "Maze.h"
+#include "Tournament.h"
 
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 #include <memory>
 
-int main()
+// parses a positive decimal count, the whole argument has to be digits
+static bool parseCount(const char* arg, size_t& count)
 {
+    // strtoull alone would skip blanks and accept a sign
+    if (!std::isdigit(static_cast<unsigned char>(arg[0])))
+        return false;
+
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long value = std::strtoull(arg, &end, 10);
+    if (value == 0 || *end != '\0' || errno == ERANGE)
+        return false;
+    count = value;
+    return true;
+}
+
+// Labyrinth [--headless [ticks]] - headless runs the battle once at full speed and prints a report
+// Labyrinth --tournament [battles] [--json] - plays that many seeded battles in parallel, prints a CSV or JSON summary;
+//     the options go in any order
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "--tournament") == 0)
+    {
+        TournamentConfig config;
+        bool json = false;
+        bool counted = false;
+        for (int i = 2; i < argc; i++)
+        {
+            if (std::strcmp(argv[i], "--json") == 0)
+            {
+                json = true;
+                continue;
+            }
+
+            // a positive decimal count, given at most once
+            if (counted || !parseCount(argv[i], config.battles))
+            {
+                std::cerr << "[ERROR]: Expected one positive number of battles, got \"" << argv[i] << "\"." << std::endl;
+                std::cerr << "Usage: Labyrinth --tournament [battles] [--json]" << std::endl;
+                return 1;
+            }
+            counted = true;
+        }
+
+        const TournamentSummary summary = Tournament(config).run();
+        json ? summary.writeJson(std::cout) : summary.writeCsv(std::cout);
+        std::cerr << "[LOG]: " << summary.battles << " battles in " << summary.seconds << " s, "
+                  << summary.getBattlesPerSecond() << " battles/s, " << summary.unfinished << " unfinished." << std::endl;
+        return 0;
+    }
+
+    // a headless battle runs flat out, so its ticks are planned on every core
+    const bool headless = argc > 1 && std::strcmp(argv[1], "--headless") == 0;
+    size_t maxTicks = 0;
+    if (headless && (argc > 3 || (argc == 3 && !parseCount(argv[2], maxTicks))))
+    {
+        std::cerr << "[ERROR]: Expected a positive tick limit, got \"" << argv[argc - 1] << "\"." << std::endl;
+        std::cerr << "Usage: Labyrinth --headless [ticks]" << std::endl;
+        return 1;
+    }
     std::shared_ptr<MazeFactory> mazeFactory = std::make_shared<SimpleMazeCreator>();
-    Application::Init(mazeFactory,20,20);
+    Application::Init(mazeFactory,20,20,0,headless ? std::make_shared<ThreadPool>() : nullptr);
     Application* app = Application::GetInstance();
 
-    app->GetBattleContext().GetRobotManager().AddRobot<SlowRobot>(app->GetMaze(),Vec2i(0),Vec2i(10));
-    app->GetBattleContext().GetRobotManager().AddRobot<SimpleRobot>(app->GetMaze(),Vec2i(0,19),Vec2i(10));
-    app->GetBattleContext().GetRobotManager().AddRobot<AngryRobot>(app->GetMaze(),Vec2i(19,0),Vec2i(10));
-    app->GetBattleContext().GetRobotManager().AddRobot<BoomRobot>(app->GetMaze(),Vec2i(19),Vec2i(10),30);
-    app->Run();
+    app->GetBattleContext().GetRobotManager().AddRobot<SlowRobots>(Vec2i(0),Vec2i(10));
+    app->GetBattleContext().GetRobotManager().AddRobot<SimpleRobots>(Vec2i(0,19),Vec2i(10));
+    app->GetBattleContext().GetRobotManager().AddRobot<AngryRobots>(Vec2i(19,0),Vec2i(10));
+    app->GetBattleContext().GetRobotManager().AddRobot<BoomRobots>(Vec2i(19),Vec2i(10),30);
+    if (headless)
+    {
+        app->GetBattleContext().RunHeadless(maxTicks).print(std::cout);
+    }
+    else
+    {
+        app->Run();
+    }
     Application::Deinit();
     return 0;
 }
\ No newline at end of file
@@ -1,99 +1,181 @@
 #include "Maze.h"
 
 #include <algorithm>
-#include <array>
+#include <chrono>
 #include <memory>
 #include <sstream>
 
 #include "utility/RandomGenerator.h"
 #include "utility/ColorfulText.h"
-#include "Robot.h"
+#include "MazeCarver.h"
+#include "utility/ThreadPool.h"
 
 Maze::Maze(size_t width, size_t height, uint32_t seed)
     : m_grid(width, height)
+    , m_seed(RandomGenerator::resolveSeed(seed))
+    , m_rng(m_seed)
 {
-    RandomGenerator::setSeed(seed);
     UpdateMaze();
 }
 
 Maze::Maze(size_t width, size_t height)
-    : m_grid(width, height)
-    , m_update(true)
+    : Maze(width, height, 0)
 {
-    RandomGenerator::setSeed();
-    UpdateMaze();
 }
 
-void Maze::UpdateMaze()
+Maze::Maze(Grid&& grid, uint32_t seed)
+    : Maze(std::move(grid), seed, true)
 {
-    size_t w = m_grid.getWidth();
-    size_t h = m_grid.getHeight();
-    m_grid = Grid(w, h);
-    // pair (x, y) - position in the grid
-    std::stack<Vec2i> mazeStack;
-
-    mazeStack.push( {0, 0} );
-    m_grid[0][0].setVisited();
-
-    // we will store all available directions here
-    std::vector<Vec2i> neighbors;
-    neighbors.reserve(4); // avoid reallocations
-
-    // we could utilize an array of neighbors to reduce shitty code
-    static constexpr std::array<Vec2i, 4> directions = {
-        Vec2i( 0, -1),
-        Vec2i( 1,  0),
-        Vec2i( 0,  1),
-        Vec2i(-1,  0),
-    };
+}
 
-    while (!mazeStack.empty())
+Maze::Maze(Grid&& grid, uint32_t seed, bool generate)
+    : m_grid(std::move(grid))
+    , m_seed(generate ? RandomGenerator::resolveSeed(seed) : seed)
+    , m_rng(m_seed)
+{
+    if (generate)
     {
-        Vec2i pos = mazeStack.top();
+        UpdateMaze();
+    }
+}
 
-        for (Vec2i delta : directions)
-        {
-            Vec2i npos = Vec2i(pos.x + delta.x, pos.y + delta.y);
-            if (npos.x < 0 || npos.y < 0 || 
-                npos.x > m_grid.getWidth() - 1 || npos.y > m_grid.getHeight() - 1 || 
-                m_grid[npos.x][npos.y].isVisited())
-            {
-                continue;
-            }
+std::shared_ptr<Maze> Maze::FromGrid(Grid&& grid, uint32_t seed)
+{
+    return std::shared_ptr<Maze>(new Maze(std::move(grid), seed, false));
+}
 
-            neighbors.push_back(delta);
-        }
+std::shared_ptr<Maze> Maze::Carve(Grid&& grid, uint32_t seed)
+{
+    Xoshiro256 rng(seed);
+    GridRegion whole = { 0, 0, grid.getWidth(), grid.getHeight() };
+    CarveBacktracker(grid, whole, [&](size_t n) { return rng.bounded(n); });
+    return FromGrid(std::move(grid), seed);
+}
 
-        if (!neighbors.empty())
-        {
-            // get location of random neighbor
-            Vec2i delta = neighbors.at(RandomGenerator::generateIndex(0, neighbors.size() - 1));
-            // we won't use operator+ overload here as we treat two different types
-            // as you may have seen above
-            Vec2i npos = Vec2i(pos.x + delta.x, pos.y + delta.y);
-
-            // get neighboring cell
-            Cell& ncell = m_grid[npos.x][npos.y];
-            // get parent cell
-            Cell& pcell = m_grid[pos.x][pos.y];
-
-            // we break a wall in both cells and mark them as visited
-            pcell.setVisited();
-            ncell.setVisited();
-            pcell.breakWall((Direction) delta);
-            ncell.breakWall(getOpposite((Direction) delta));
-            mazeStack.push(npos);
-
-            // capacity of vector is untouched, so no std::vector::reserve() is needed
-            neighbors.clear();
-        }
-        else mazeStack.pop();
+Grid::Grid(size_t width, size_t height)
+    : m_width(width)
+    , m_height(height)
+    , m_stride(width + 2)
+    , m_size((width + 2) * (height + 2))
+    , m_heap(m_size)
+    , m_cells(m_heap.data())
+{
+    buildOffsets();
+    writeBorder();
+}
+
+Grid::Grid(size_t width, size_t height, size_t tileShift, std::unique_ptr<MappedFile> file, size_t offset)
+    : m_width(width)
+    , m_height(height)
+    , m_stride(tileShift ? ((width + 2) + (size_t(1) << tileShift) - 1) >> tileShift : width + 2)
+    , m_tileShift(tileShift)
+    , m_size(StorageSize(width, height, tileShift))
+    , m_file(std::move(file))
+    , m_cells(m_file ? reinterpret_cast<Cell*>(m_file->data() + offset) : nullptr)
+{
+    buildOffsets();
+}
+
+void Grid::buildOffsets()
+{
+    m_rowOffsets.resize(m_height + 2);
+    m_columnOffsets.resize(m_width + 2);
+    if (m_tileShift == 0)
+    {
+        for (size_t y = 0; y < m_rowOffsets.size(); y++)
+            m_rowOffsets[y] = y * m_stride;
+        for (size_t x = 0; x < m_columnOffsets.size(); x++)
+            m_columnOffsets[x] = x;
+        return;
+    }
+
+    // tile (ty * stride + tx) starts at its index << 2 * tileShift, cells inside it are row-major;
+    // the row part and the column part of that index occupy disjoint terms, so they simply add up
+    const size_t mask = (size_t(1) << m_tileShift) - 1;
+    for (size_t y = 0; y < m_rowOffsets.size(); y++)
+        m_rowOffsets[y] = (((y >> m_tileShift) * m_stride) << (2 * m_tileShift)) + ((y & mask) << m_tileShift);
+    for (size_t x = 0; x < m_columnOffsets.size(); x++)
+        m_columnOffsets[x] = ((x >> m_tileShift) << (2 * m_tileShift)) + (x & mask);
+}
+
+Grid Grid::Pooled(size_t width, size_t height, std::shared_ptr<Cell[]> pool, size_t offset)
+{
+    Grid grid(width, height, 0, nullptr, 0);
+    grid.m_pool = std::move(pool);
+    grid.m_cells = grid.m_pool.get() + offset;
+    grid.writeBorder();
+    return grid;
+}
+
+size_t Grid::StorageSize(size_t width, size_t height, size_t tileShift)
+{
+    if (tileShift == 0)
+        return (width + 2) * (height + 2);
+
+    const size_t tileSide = size_t(1) << tileShift;
+    const size_t tilesX = ((width + 2) + tileSide - 1) / tileSide;
+    const size_t tilesY = ((height + 2) + tileSide - 1) / tileSide;
+    return tilesX * tilesY * tileSide * tileSide;
+}
+
+Grid Grid::Mapped(size_t width, size_t height, const std::filesystem::path& path, size_t tileShift)
+{
+    const size_t bytes = StorageSize(width, height, tileShift) * sizeof(Cell);
+
+    Grid grid(width, height, tileShift, std::make_unique<MappedFile>(path, bytes), 0);
+    grid.writeBorder();
+    return grid;
+}
+
+Grid Grid::Adopt(size_t width, size_t height, size_t tileShift, std::unique_ptr<MappedFile> file, size_t offset)
+{
+    return Grid(width, height, tileShift, std::move(file), offset);
+}
+
+void Grid::writeBorder()
+{
+    Cell sentinel;
+    sentinel.setVisited();
+
+    // top and bottom border rows, corners included
+    for (size_t x = -1; x != m_width + 1; x++)
+    {
+        cell(x, -1) = sentinel;
+        cell(x, m_height) = sentinel;
     }
+    // left and right border columns
+    for (size_t y = 0; y < m_height; y++)
+    {
+        cell(-1, y) = sentinel;
+        cell(m_width, y) = sentinel;
+    }
+}
+
+void Grid::reset()
+{
+    std::fill_n(m_cells, m_size, Cell());
+    writeBorder();
+}
+
+void Grid::flush()
+{
+    if (m_file)
+        m_file->flush();
+}
+
+void Maze::UpdateMaze()
+{
+    m_grid.reset();
+
+    GridRegion whole = { 0, 0, m_grid.getWidth(), m_grid.getHeight() };
+    CarveBacktracker(m_grid, whole, [this](size_t n) { return m_rng.bounded(n); });
+    // nothing before a regeneration can be replayed on top of it
+    m_journal.restart();
 }
 
 bool Maze::breakWall(const Vec2i& pos, const Vec2i& delta)
 {
-    Cell& cell = m_grid[pos.x][pos.y];
+    Cell& cell = m_grid.cell(pos.x, pos.y);
     Vec2i npos = pos + delta;
     if(cell.hasPath((Direction) delta))
     {
@@ -104,10 +186,10 @@ bool Maze::breakWall(const Vec2i& pos, const Vec2i& delta)
     {
         return false;
     }
-    Cell& ncell = m_grid[npos.x][npos.y];
+    Cell& ncell = m_grid.cell(npos.x, npos.y);
     cell.breakWall((Direction) delta);
     ncell.breakWall(getOpposite((Direction) delta));
-    m_update = true;
+    m_journal.record({ pos, delta });
     return true;
 }
 
@@ -135,7 +217,7 @@ void MazePrinter::PrintInConsole(Maze* maze, std::optional<cref_type<path_contai
             if (pathWay)
             {
                 std::stringstream oss;
-                if (!(*maze)[x][y].hasPath(Direction::NORTH))
+                if (!maze->cell(x, y).hasPath(Direction::NORTH))
                 {
                     std::cout << "##";
                 }
@@ -148,7 +230,7 @@ void MazePrinter::PrintInConsole(Maze* maze, std::optional<cref_type<path_contai
             }
             else
             {
-                std::cout << (!(*maze)[x][y].hasPath(Direction::NORTH) ? "##" : "# ");
+                std::cout << (!maze->cell(x, y).hasPath(Direction::NORTH) ? "##" : "# ");
             }
 
             pathWay = false;
@@ -163,7 +245,7 @@ void MazePrinter::PrintInConsole(Maze* maze, std::optional<cref_type<path_contai
             {
                 std::stringstream oss;
                 oss << ".";
-                if (!(*maze)[x][y].hasPath(Direction::WEST))
+                if (!maze->cell(x, y).hasPath(Direction::WEST))
                 {
                     std::cout << "#";
                     PrintColorful(oss.str(), 6);
@@ -176,7 +258,7 @@ void MazePrinter::PrintInConsole(Maze* maze, std::optional<cref_type<path_contai
             }
             else
             {
-                std::cout << (!(*maze)[x][y].hasPath(Direction::WEST) ? "# " : "  ");
+                std::cout << (!maze->cell(x, y).hasPath(Direction::WEST) ? "# " : "  ");
             }
 
             pathWay = false;
@@ -219,7 +301,7 @@ void MazePrinter::PrintInConsoleBold(Maze* maze, std::optional<cref_type<path_co
 
             for (size_t x = 0; x < maze->getWidth(); x++)
             {
-                Cell& curr = (*maze)[x][y];
+                Cell& curr = maze->cell(x, y);
 
                 pathWay = is_path(x, y);
 
@@ -275,98 +357,37 @@ void MazePrinter::PrintInConsoleBold(Maze* maze, std::optional<cref_type<path_co
     }
 }
 
-void MazePrinter::PrintInConsoleRobots(Maze* maze, std::vector<IRobot*>& robots, Vec2i& goal)
+uint32_t MazeFactory::DeriveSeed(uint32_t baseSeed, uint64_t index)
 {
-    std::array<char, static_cast<size_t>(Robots::UNKNOWN)> robotSymbols = {
-        'A',
-        'B',
-        's',
-        'S'
-    };
-    char robotChar = 'u';
-    size_t robotsOnOneCell = 0;
-    size_t color = 0;
+    // never 0, that would read as "unknown seed"
+    uint32_t seed = static_cast<uint32_t>(Xoshiro256::stream(baseSeed, index)() >> 32);
+    return seed != 0 ? seed : 1;
+}
 
-    auto isRobotPos = [&](size_t x, size_t y) -> void
-    {
-        for (size_t i = 0; i < robots.size(); ++i)
-        {
-            if (robots[i]->getPos().x == x && robots[i]->getPos().y == y)
-            {
-                ++robotsOnOneCell;
-                robotChar = robotSymbols[static_cast<size_t>(robots[i]->getRobotType())];
-                color = static_cast<size_t>(robots[i]->getRobotType());
-            }
-        }
-    };
+MazeBatch MazeFactory::CarveBatch(size_t count, size_t width, size_t height, uint32_t baseSeed, ThreadPool* pool)
+{
+    auto startTime = std::chrono::steady_clock::now();
 
-    for (size_t y = 0; y < maze->getHeight(); y++)
+    std::unique_ptr<ThreadPool> ownPool;
+    if (!pool)
     {
-        for (size_t x = 0; x < maze->getWidth(); x++)
-        {
-            std::cout << (!(*maze)[x][y].hasPath(Direction::NORTH) ? "##" : "# ");
-        }
-        std::cout << "#" << std::endl;
-
-        for (size_t x = 0; x < maze->getWidth(); x++)
-        {
-            isRobotPos(x, y);
-            if (robotsOnOneCell > 0)
-            {
-                std::stringstream oss1, oss2;
-                if (robotsOnOneCell > 1)
-                {
-                    oss1 << robotsOnOneCell;
-                    oss2 << " " << robotsOnOneCell;
-                    color = 5;
-                }
-                else
-                {
-                    oss1 << robotChar;
-                    oss2 << " " << robotChar;
-                }
-
-                if (!(*maze)[x][y].hasPath(Direction::WEST))
-                {
-                    std::cout << "#";
-                    PrintColorful(oss1.str(), color);
-                }
-                else
-                {
-                    PrintColorful(oss2.str(), color);
-                }
-            }
-            else if (goal.x == x && goal.y == y)
-            {
-                std::stringstream oss;
-                oss << "0";
-
-                if (!(*maze)[x][y].hasPath(Direction::WEST))
-                {
-                    std::cout << "#";
-                    PrintColorful(oss.str(), 5);
-                }
-                else
-                {
-                    std::cout << " ";
-                    PrintColorful(oss.str(), 5);
-                }
-            }
-            else
-            {
-                std::cout << (!(*maze)[x][y].hasPath(Direction::WEST) ? "# " : "  ");
-            }
-            robotsOnOneCell = 0;
-        }
-        std::cout << "#" << std::endl;
+        ownPool = std::make_unique<ThreadPool>();
+        pool = ownPool.get();
     }
 
-    for (size_t x = 0; x < maze->getWidth(); x++)
+    MazeBatch batch;
+    const size_t cellsPerMaze = Grid::StorageSize(width, height, 0);
+    batch.storage = std::make_shared<Cell[]>(count * cellsPerMaze);
+    batch.mazes.resize(count);
+
+    pool->parallelFor(count, [&](size_t i)
     {
-        std::cout << "##";
-    }
+        // derived seeds double as the recorded seed of each maze
+        batch.mazes[i] = Maze::Carve(Grid::Pooled(width, height, batch.storage, i * cellsPerMaze), DeriveSeed(baseSeed, i));
+    });
 
-    std::cout << "#" << std::endl;
+    batch.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return batch;
 }
 
 std::shared_ptr<Maze> SimpleMazeCreator::createMaze(size_t width, size_t height, uint32_t seed) const
@@ -376,3 +397,8 @@ std::shared_ptr<Maze> SimpleMazeCreator::createMaze(size_t width, size_t height,
 
     return std::shared_ptr<Maze>(new Maze(width, height));
 }
+
+std::shared_ptr<Maze> MappedMazeCreator::createMaze(size_t width, size_t height, uint32_t seed) const
+{
+    return std::make_shared<Maze>(Grid::Mapped(width, height, m_path, m_tileShift), seed);
+}
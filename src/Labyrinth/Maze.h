@@ -1,14 +1,20 @@
 #pragma once
 
+#include <cstddef>
 #include <iostream>
 #include <stack>
 #include <vector>
 #include <optional>
 #include <utility>
 #include <memory>
+#include <bit>
+#include <filesystem>
 
 #include "utility/Vec2.h"
 #include "utility/Direction.h"
+#include "utility/MappedFile.h"
+#include "utility/RandomGenerator.h"
+#include "MazeJournal.h"
 
 /**
  * @brief This class represents a single "node" of a maze 
@@ -29,116 +35,207 @@ public:
 
     inline constexpr uint8_t getValue() const { return m_cellNode & 0b1111; }
 
+    // direction back to the cell this one was carved from, only meaningful while generating
+    inline constexpr void setParent(const Direction& dir) { m_cellNode = (m_cellNode & 0b10011111) | (std::countr_zero(static_cast<uint8_t>(dir)) << 5); }
+    inline constexpr Direction getParent() const { return static_cast<Direction>(1 << ((m_cellNode >> 5) & 0b11)); }
+
     friend std::iostream& operator<<(std::iostream& stream, const Cell& cell) { /*NOIMPL!*/ return stream; };
 
 private:
     uint8_t m_cellNode = 0b00000;
 };
 
+class Grid;
+
+/**
+ * @brief Non-owning view over the cells of a Grid that share one x coordinate
+ *
+ * Kept for (*maze)[x][y] style access, hot loops should prefer Grid::cell(x, y).
+ */
 class Row
 {
 public:
-    using container_type = std::vector<Cell>;
-    using iterator_type = container_type::iterator;
-    using const_iterator_type = container_type::const_iterator;
-
-public:
-    Row() = default;
-    Row(size_t height)
-        : m_cells(height, Cell())
-    {   
+    constexpr Row(Grid* grid, size_t x)
+        : m_grid(grid)
+        , m_x(x)
+    {
     }
     ~Row() = default;
 
-    inline constexpr Cell& operator[](size_t idx) { return m_cells.at(idx); }
-    inline constexpr const Cell& operator[](size_t idx) const { return m_cells.at(idx); }
+    inline Cell& operator[](size_t idx) const;
 
-    inline constexpr size_t getHeight() const { return m_cells.size(); }
-    inline constexpr void setHeight(size_t height) { m_cells.resize(height); }
+private:
+    Grid* m_grid;
+    size_t m_x;
+};
 
-    // Iterator & for-each support
-    inline constexpr iterator_type begin() noexcept { return m_cells.begin(); }
-    inline constexpr const_iterator_type cbegin() const noexcept { return m_cells.cbegin(); }
-    inline constexpr iterator_type end() noexcept { return m_cells.end(); }
-    inline constexpr const_iterator_type cend() const noexcept { return m_cells.cend(); }
+/**
+ * @brief Read-only counterpart of Row, handed out by the const operator[]
+ */
+class ConstRow
+{
+public:
+    constexpr ConstRow(const Grid* grid, size_t x)
+        : m_grid(grid)
+        , m_x(x)
+    {
+    }
+    ~ConstRow() = default;
 
-    inline constexpr Cell& front() { return m_cells.front(); }
-    inline constexpr Cell& back() { return m_cells.back(); }
+    inline const Cell& operator[](size_t idx) const;
 
 private:
-    std::vector<Cell> m_cells;
+    const Grid* m_grid;
+    size_t m_x;
 };
 
 /**
- * @brief Basically, thid Grid class is a wrapper for 2D std::vector with easy-to-use interface 
+ * @brief Basically, this Grid class is a single contiguous buffer of cells with easy-to-use interface
  *
+ * The buffer is surrounded by a one cell wide sentinel border: border cells have no passages and are
+ * marked visited, so any cell's neighbor can be read without bounds checks, including for x == -1 or y == -1
+ * (the unsigned wrap-around of such coordinates is folded back by index()).
+ *
+ * Cells either live on the heap in row-major order, or in a memory-mapped file (see Grid::Mapped) split
+ * into square tiles of 2^tileShift cells a side, so that a neighborhood of cells shares a few pages and
+ * the OS can page tiles in and out on demand for mazes larger than physical memory. The layout is resolved
+ * once into per-row and per-column offset tables, so index() costs the same for either and never branches.
  */
 class Grid
 {
 public:
-    using container_type = std::vector<Row>;
-    using iterator_type = container_type::iterator;
-    using const_iterator_type = container_type::const_iterator;
+    // 64x64 one-byte cells - one 4 KiB page per tile
+    static constexpr size_t DEFAULT_TILE_SHIFT = 6;
 
 public:
-    Grid(size_t width, size_t height)
-        : m_height(height)
-        , m_rows(width, Row(height))
+    Grid(size_t width, size_t height);
+    ~Grid() = default;
+
+    Grid(const Grid&) = delete;
+    Grid& operator=(const Grid&) = delete;
+    Grid(Grid&&) noexcept = default;
+    Grid& operator=(Grid&&) noexcept = default;
+
+    // creates the backing file (overwriting it) and lays the cells out in tiles
+    static Grid Mapped(size_t width, size_t height, const std::filesystem::path& path, size_t tileShift = DEFAULT_TILE_SHIFT);
+    // takes over cells that are already laid out (border included) at byte offset of the mapping
+    static Grid Adopt(size_t width, size_t height, size_t tileShift, std::unique_ptr<MappedFile> file, size_t offset);
+    // row-major grid inside a larger zeroed allocation shared with other grids, starting at cell offset
+    static Grid Pooled(size_t width, size_t height, std::shared_ptr<Cell[]> pool, size_t offset);
+    // number of cells in the buffer of such a grid, tileShift == 0 meaning row-major
+    static size_t StorageSize(size_t width, size_t height, size_t tileShift);
+
+    // unchecked accessors, (x, y) may address the sentinel border
+    inline constexpr size_t index(size_t x, size_t y) const
     {
+        // sentinel border shifts everything by one cell
+        return m_rowOffsets[y + 1] + m_columnOffsets[x + 1];
     }
-    ~Grid() = default;
+    inline constexpr Cell& cell(size_t x, size_t y) { return m_cells[index(x, y)]; }
+    inline constexpr const Cell& cell(size_t x, size_t y) const { return m_cells[index(x, y)]; }
+
+    inline Row operator[](size_t idx) { return Row(this, idx); }
+    inline ConstRow operator[](size_t idx) const { return ConstRow(this, idx); }
 
-    inline constexpr Row& operator[](size_t idx) { return m_rows.at(idx); }
-    inline constexpr const Row& operator[](size_t idx) const { return m_rows.at(idx); }
+    inline constexpr size_t getWidth() const { return m_width; }
+    inline constexpr size_t getHeight() const { return m_height; }
+    // distance between vertically adjacent cells in the buffer, tiles per tile row for a tiled grid
+    inline constexpr size_t getStride() const { return m_stride; }
+    inline constexpr bool isTiled() const { return m_tileShift != 0; }
+    inline constexpr size_t getTileShift() const { return m_tileShift; }
 
-    inline constexpr size_t getWidth() const { return m_rows.size(); }
-    inline void setWidth(size_t width) { m_rows.resize(width, Row(m_height)); }
+    // offset to add to an index() to reach the neighbor in the given direction, row-major grids only
+    inline constexpr ptrdiff_t offset(Direction dir) const
+    {
+        switch (dir)
+        {
+        case Direction::NORTH: return -static_cast<ptrdiff_t>(m_stride);
+        case Direction::EAST:  return 1;
+        case Direction::SOUTH: return static_cast<ptrdiff_t>(m_stride);
+        case Direction::WEST:  return -1;
+        default: return 0;
+        }
+    }
 
-    // we assert, that m_rows[i] and m_rows[j] will always have the same height 
-    inline constexpr size_t getHeight() const { return m_rows[0].getHeight(); }
-    void setHeight(size_t height) { for (Row& row : m_rows) row.setHeight(height); }
+    // raw buffer including the sentinel border (and tile padding for a tiled grid)
+    inline Cell* data() noexcept { return m_cells; }
+    inline const Cell* data() const noexcept { return m_cells; }
+    inline size_t size() const noexcept { return m_size; }
 
-    // Iterator & for-each support
-    inline constexpr iterator_type begin() noexcept { return m_rows.begin(); }
-    inline constexpr const_iterator_type cbegin() const noexcept { return m_rows.cbegin(); }
-    inline constexpr iterator_type end() noexcept { return m_rows.end(); }
-    inline constexpr const_iterator_type cend() const noexcept { return m_rows.cend(); }
+    // walls up every cell and restores the sentinel border, keeping the allocation
+    void reset();
+    // writes dirty pages of a mapped grid back to its file, no-op for the heap
+    void flush();
 
-    inline constexpr Row& front() { return m_rows.front(); }
-    inline constexpr Row& back() { return m_rows.back(); }
+private:
+    Grid(size_t width, size_t height, size_t tileShift, std::unique_ptr<MappedFile> file, size_t offset);
 
-    // by standard, capacity of the vector is left untouched - what we need
-    void clear() { m_rows.clear(); }
+    // resolves the layout once: index() is the sum of a row and a column offset, whatever the layout
+    void buildOffsets();
+    // storage starts zeroed - all walls, nothing visited - so only the border needs writing
+    void writeBorder();
 
 private:
+    size_t m_width;
     size_t m_height;
-    std::vector<Row> m_rows;
+    size_t m_stride;
+    size_t m_tileShift = 0;
+    size_t m_size;
+    // buffer offset of every row and column, border included
+    std::vector<size_t> m_rowOffsets;
+    std::vector<size_t> m_columnOffsets;
+    std::vector<Cell> m_heap;
+    std::unique_ptr<MappedFile> m_file;
+    std::shared_ptr<Cell[]> m_pool;
+    Cell* m_cells;
 };
 
+inline Cell& Row::operator[](size_t idx) const { return m_grid->cell(m_x, idx); }
+inline const Cell& ConstRow::operator[](size_t idx) const { return m_grid->cell(m_x, idx); }
+
 class Maze
 {
 public:
     Maze(size_t width, size_t height, uint32_t seed);
     Maze(size_t width, size_t height);
+    // generates into already allocated storage, e.g. a Grid::Mapped one
+    Maze(Grid&& grid, uint32_t seed = 0);
     ~Maze() = default;
 
-    inline constexpr Row& operator[](size_t idx) { return m_grid.operator[](idx); }
-    inline constexpr const Row& operator[](size_t idx) const { return m_grid.operator[](idx); }
-    
+    inline Row operator[](size_t idx) { return m_grid[idx]; }
+    inline ConstRow operator[](size_t idx) const { return m_grid[idx]; }
+    inline constexpr Cell& cell(size_t x, size_t y) { return m_grid.cell(x, y); }
+    inline constexpr const Cell& cell(size_t x, size_t y) const { return m_grid.cell(x, y); }
+    inline constexpr const Grid& getGrid() const { return m_grid; }
+    // seed the maze was last generated with, 0 if it is unknown
+    inline constexpr uint32_t getSeed() const { return m_seed; }
+
+    // wraps an already generated grid, e.g. one loaded from a snapshot, without touching its cells
+    static std::shared_ptr<Maze> FromGrid(Grid&& grid, uint32_t seed);
+    // carves grid with the backtracker on a private RNG stream seeded with seed, safe to call from any thread
+    static std::shared_ptr<Maze> Carve(Grid&& grid, uint32_t seed);
+
     inline constexpr size_t getWidth() const { return m_grid.getWidth(); }  
     inline constexpr size_t getHeight() const { return m_grid.getHeight(); }
     bool breakWall(const Vec2i& pos, const Vec2i& delta);
-    inline constexpr bool getUpdateState() const { return m_update; }
-    inline void handleUpdate(){ m_update = false; }
+    // bumped by every change to the passages, consumers compare it with the last version they saw to detect updates
+    inline uint64_t getVersion() const { return m_journal.getVersion(); }
+    // every wall broken since the last regeneration, for consumers that only want to process the delta
+    inline MazeJournal& getJournal() { return m_journal; }
+    inline const MazeJournal& getJournal() const { return m_journal; }
 
     void UpdateMaze();
+private:
+    Maze(Grid&& grid, uint32_t seed, bool generate);
+
 private:
     Grid m_grid;
-    bool m_update;
+    uint32_t m_seed = 0;
+    // carries on between regenerations, so UpdateMaze() gives a new maze every time
+    Xoshiro256 m_rng;
+    MazeJournal m_journal;
 };
 
-class IRobot;
-
 class MazePrinter
 {
 public:
@@ -155,7 +252,20 @@ public:
         std::optional<cref_type<path_container_type>> path = std::nullopt);
     static void PrintInConsoleBold(Maze* maze,
         std::optional<cref_type<path_container_type>> path = std::nullopt);
-    static void PrintInConsoleRobots(Maze* maze, std::vector<IRobot*>& robots, Vec2i& goal);
+};
+
+class ThreadPool;
+
+/**
+ * @brief Result of MazeFactory::CarveBatch - every maze is backed by the one shared cell allocation
+ */
+struct MazeBatch
+{
+    std::vector<std::shared_ptr<Maze>> mazes;
+    std::shared_ptr<Cell[]> storage;
+    double seconds = 0.0;
+
+    inline double getMazesPerSecond() const { return seconds > 0.0 ? mazes.size() / seconds : 0.0; }
 };
 
 class MazeFactory
@@ -165,9 +275,41 @@ public:
     virtual ~MazeFactory() = default;
 
     virtual std::shared_ptr<Maze> createMaze(size_t width, size_t height, uint32_t seed = 0) const = 0;
+
+    /**
+     * @brief Carves count mazes with the recursive backtracker, concurrently, into a single pooled allocation
+     *
+     * Maze i is carved with its own RNG stream derived from (baseSeed, i) and records the derived seed,
+     * so a batch is reproducible for any thread count. Always the backtracker, whatever factory is at hand.
+     *
+     * @param pool workers to run on, a temporary pool of hardware_concurrency() threads if nullptr
+     */
+    static MazeBatch CarveBatch(size_t count, size_t width, size_t height, uint32_t baseSeed, ThreadPool* pool = nullptr);
+
+    // seed of maze index in a batch started from baseSeed
+    static uint32_t DeriveSeed(uint32_t baseSeed, uint64_t index);
 };
 
 class SimpleMazeCreator : public MazeFactory
 {
     virtual std::shared_ptr<Maze> createMaze(size_t width, size_t height, uint32_t seed = 0) const override;
+};
+
+/**
+ * @brief Creates mazes whose cells live in a tiled, memory-mapped file instead of the heap
+ */
+class MappedMazeCreator : public MazeFactory
+{
+public:
+    MappedMazeCreator(const std::filesystem::path& path, size_t tileShift = Grid::DEFAULT_TILE_SHIFT)
+        : m_path(path)
+        , m_tileShift(tileShift)
+    {
+    }
+
+    virtual std::shared_ptr<Maze> createMaze(size_t width, size_t height, uint32_t seed = 0) const override;
+
+private:
+    std::filesystem::path m_path;
+    size_t m_tileShift;
 };
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Maze.h"
+
+/**
+ * @brief Rectangle of cells [x0, x1) x [y0, y1) a generator is allowed to touch
+ */
+struct GridRegion
+{
+    size_t x0 = 0;
+    size_t y0 = 0;
+    size_t x1 = 0;
+    size_t y1 = 0;
+
+    inline constexpr size_t getWidth() const { return x1 - x0; }
+    inline constexpr size_t getHeight() const { return y1 - y0; }
+    // unsigned wrap-around makes coordinates left/above the region fail too
+    inline constexpr bool contains(size_t x, size_t y) const { return x - x0 < getWidth() && y - y0 < getHeight(); }
+};
+
+/**
+ * @brief Recursive backtracker confined to one region of a grid, starting at its north-west corner
+ *
+ * Instead of a stack of positions, every carved cell remembers the direction back to its parent,
+ * so backtracking needs no memory beyond the grid itself. Cells outside the region are never read
+ * or written, which lets disjoint regions be carved concurrently.
+ *
+ * @param pick returns a uniformly random index in [0, n) for the given n
+ */
+template<typename PickFn>
+void CarveBacktracker(Grid& grid, const GridRegion& region, PickFn&& pick)
+{
+    static constexpr std::array<Vec2i, 4> directions = {
+        Vec2i( 0, -1),
+        Vec2i( 1,  0),
+        Vec2i( 0,  1),
+        Vec2i(-1,  0),
+    };
+
+    const Vec2i start = Vec2i(static_cast<int32_t>(region.x0), static_cast<int32_t>(region.y0));
+    Vec2i pos = start;
+    grid.cell(start.x, start.y).setVisited();
+
+    // we will store all available directions here
+    std::array<Vec2i, 4> neighbors;
+    size_t neighborCount = 0;
+
+    while (true)
+    {
+        for (Vec2i delta : directions)
+        {
+            Vec2i npos = Vec2i(pos.x + delta.x, pos.y + delta.y);
+            if (!region.contains(npos.x, npos.y) || grid.cell(npos.x, npos.y).isVisited())
+            {
+                continue;
+            }
+
+            neighbors[neighborCount++] = delta;
+        }
+
+        if (neighborCount > 0)
+        {
+            // get location of random neighbor
+            Vec2i delta = neighbors[pick(neighborCount)];
+            Vec2i npos = Vec2i(pos.x + delta.x, pos.y + delta.y);
+
+            Cell& ncell = grid.cell(npos.x, npos.y);
+            Cell& pcell = grid.cell(pos.x, pos.y);
+
+            // we break a wall in both cells and mark them as visited
+            pcell.setVisited();
+            ncell.setVisited();
+            pcell.breakWall((Direction) delta);
+            ncell.breakWall(getOpposite((Direction) delta));
+            ncell.setParent(getOpposite((Direction) delta));
+            pos = npos;
+
+            neighborCount = 0;
+        }
+        else if (pos == start)
+        {
+            break;
+        }
+        else
+        {
+            pos = pos + Vec2i::FromDirection(grid.cell(pos.x, pos.y).getParent());
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#include "MazeJournal.h"
+
+#include <algorithm>
+
+MazeJournal::Cursor::Cursor(MazeJournal& journal)
+    : m_journal(&journal)
+{
+    auto it = std::find_if(journal.m_subscribers.begin(), journal.m_subscribers.end(), [](const Slot& slot) { return !slot.used; });
+    if (it == journal.m_subscribers.end())
+        it = journal.m_subscribers.insert(it, Slot{});
+    *it = { true, UNSYNCED };
+    m_slot = it - journal.m_subscribers.begin();
+}
+
+MazeJournal::Cursor::~Cursor()
+{
+    m_journal->m_subscribers[m_slot].used = false;
+}
+
+void MazeJournal::Cursor::advance()
+{
+    m_seen = m_journal->getVersion();
+    m_journal->m_subscribers[m_slot].seen = m_seen;
+    m_journal->compact();
+}
+
+void MazeJournal::record(const MazeChange& change)
+{
+    m_entries.push_back(change);
+    ++m_version;
+    if (m_entries.size() > m_limit)
+        compact();
+}
+
+void MazeJournal::restart()
+{
+    m_entries.clear();
+    ++m_version;
+    m_base = m_version;
+}
+
+std::optional<std::span<const MazeChange>> MazeJournal::changesSince(uint64_t version) const
+{
+    if (version < m_base || version > m_version)
+        return std::nullopt;
+    return std::span<const MazeChange>(m_entries).subspan(version - m_base);
+}
+
+void MazeJournal::compact()
+{
+    // unsynced subscribers will rebuild anyway and hold nothing back
+    uint64_t oldest = m_version;
+    for (const Slot& slot : m_subscribers)
+    {
+        if (slot.used && slot.seen != UNSYNCED)
+            oldest = std::min(oldest, slot.seen);
+    }
+    // past the limit, lagging subscribers lose the older half and rebuild on their next read
+    if (m_entries.size() > m_limit)
+        oldest = std::max(oldest, m_version - m_limit / 2);
+
+    // erase in bulk once at least half the entries are dead, so appends stay amortized O(1)
+    const size_t dead = oldest > m_base ? static_cast<size_t>(oldest - m_base) : 0;
+    if (dead == 0 || (dead < m_entries.size() / 2 && m_entries.size() <= m_limit))
+        return;
+
+    m_entries.erase(m_entries.begin(), m_entries.begin() + dead);
+    m_base = oldest;
+}
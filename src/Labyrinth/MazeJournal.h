@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "utility/Vec2.h"
+
+/**
+ * @brief A wall opened by Maze::breakWall, between pos and pos + delta
+ */
+struct MazeChange
+{
+    Vec2i pos;
+    Vec2i delta;
+};
+
+/**
+ * @brief Append-only log of the walls a maze opened, one version per entry
+ *
+ * Any consumer can ask for the changes since the version it last processed and handle only that delta.
+ * Entries are dropped once every subscribed Cursor has moved past them, or when the journal outgrows
+ * its limit; a consumer asking for changes that are gone, or that predate a regeneration, gets
+ * std::nullopt and has to treat everything as changed.
+ */
+class MazeJournal
+{
+public:
+    // entries kept for a subscriber that stopped catching up, beyond it that subscriber gets a full rebuild
+    static constexpr size_t DEFAULT_LIMIT = size_t(1) << 16;
+
+    /**
+     * @brief A subscriber's position in the journal, holding back compaction of what it has not seen
+     *
+     * Starts out unsynced: pending() reports std::nullopt until the first advance().
+     * Must not outlive the journal it reads.
+     */
+    class Cursor
+    {
+    public:
+        explicit Cursor(MazeJournal& journal);
+        ~Cursor();
+
+        Cursor(const Cursor&) = delete;
+        Cursor& operator=(const Cursor&) = delete;
+
+        // changes since the last advance(), std::nullopt if they are no longer known
+        inline std::optional<std::span<const MazeChange>> pending() const { return m_journal->changesSince(m_seen); }
+        inline bool isCurrent() const { return m_seen == m_journal->getVersion(); }
+        // marks everything recorded so far as processed
+        void advance();
+
+    private:
+        MazeJournal* m_journal;
+        size_t m_slot;
+        uint64_t m_seen = UNSYNCED;
+    };
+
+public:
+    MazeJournal(size_t limit = DEFAULT_LIMIT)
+        : m_limit(limit)
+    {
+    }
+
+    MazeJournal(const MazeJournal&) = delete;
+    MazeJournal& operator=(const MazeJournal&) = delete;
+
+    // appends one change, advancing the version
+    void record(const MazeChange& change);
+    // the maze was rebuilt as a whole: advances the version and forgets every change
+    void restart();
+
+    inline uint64_t getVersion() const { return m_version; }
+    // oldest version changesSince() can still answer for
+    inline uint64_t getBase() const { return m_base; }
+
+    // changes that took the maze from version to getVersion(), std::nullopt if they are no longer known
+    std::optional<std::span<const MazeChange>> changesSince(uint64_t version) const;
+
+private:
+    static constexpr uint64_t UNSYNCED = UINT64_MAX;
+
+    struct Slot
+    {
+        bool used;
+        uint64_t seen;
+    };
+
+    // drops the entries every subscriber has seen, and the oldest ones beyond the limit
+    void compact();
+
+private:
+    // entry i took the maze from version m_base + i to m_base + i + 1
+    std::vector<MazeChange> m_entries;
+    uint64_t m_base = 0;
+    uint64_t m_version = 0;
+    size_t m_limit;
+    std::vector<Slot> m_subscribers;
+};
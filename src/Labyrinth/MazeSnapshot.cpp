@@ -0,0 +1,240 @@
+#include "MazeSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "utility/MappedFile.h"
+
+static_assert(sizeof(Cell) == 1, "snapshot payload is the raw cell buffer");
+static_assert(sizeof(MazeSnapshotHeader) == 64, "snapshot header layout must stay fixed");
+
+// pathfinders read neighbors without bounds checks, so no passage may lead off the grid: the sentinel border
+// has to be walled up and edge cells must not open towards it. Touches only the border, O(width + height)
+static bool hasSealedBorder(const Grid& grid)
+{
+    const size_t width = grid.getWidth();
+    const size_t height = grid.getHeight();
+
+    for (size_t x = -1; x != width + 1; x++)
+    {
+        if (grid.cell(x, -1).getValue() != 0 || grid.cell(x, height).getValue() != 0)
+            return false;
+    }
+    for (size_t y = 0; y < height; y++)
+    {
+        if (grid.cell(-1, y).getValue() != 0 || grid.cell(width, y).getValue() != 0)
+            return false;
+    }
+
+    for (size_t x = 0; x < width; x++)
+    {
+        if (grid.cell(x, 0).hasPath(Direction::NORTH) || grid.cell(x, height - 1).hasPath(Direction::SOUTH))
+            return false;
+    }
+    for (size_t y = 0; y < height; y++)
+    {
+        if (grid.cell(0, y).hasPath(Direction::WEST) || grid.cell(width - 1, y).hasPath(Direction::EAST))
+            return false;
+    }
+    return true;
+}
+
+void MazeSnapshot::Save(const Maze& maze, const std::filesystem::path& path)
+{
+    const Grid& grid = maze.getGrid();
+
+    MazeSnapshotHeader header{};
+    std::memcpy(header.magic, MazeSnapshotHeader::MAGIC, sizeof(header.magic));
+    header.version = MazeSnapshotHeader::VERSION;
+    header.endianTag = MazeSnapshotHeader::ENDIAN_TAG;
+    header.width = grid.getWidth();
+    header.height = grid.getHeight();
+    header.seed = maze.getSeed();
+    header.tileShift = static_cast<uint32_t>(grid.getTileShift());
+    header.payloadOffset = MazeSnapshotHeader::PAYLOAD_ALIGNMENT;
+    header.payloadSize = grid.size() * sizeof(Cell);
+    header.checksum = Checksum(grid.data(), header.payloadSize);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("MazeSnapshot: cannot open " + path.string() + " for writing");
+
+    std::vector<char> padding(header.payloadOffset - sizeof(header), 0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding.data(), padding.size());
+    file.write(reinterpret_cast<const char*>(grid.data()), header.payloadSize);
+
+    if (!file)
+        throw std::runtime_error("MazeSnapshot: failed writing " + path.string());
+}
+
+std::shared_ptr<Maze> MazeSnapshot::Load(const std::filesystem::path& path, bool verifyChecksum)
+{
+    auto file = std::make_unique<MappedFile>(path, MappedFile::Mode::COPY_ON_WRITE);
+
+    auto fail = [&](const char* what)
+    {
+        return std::runtime_error("MazeSnapshot: " + path.string() + ": " + what);
+    };
+
+    if (file->size() < sizeof(MazeSnapshotHeader))
+        throw fail("file is too small");
+
+    MazeSnapshotHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+
+    if (std::memcmp(header.magic, MazeSnapshotHeader::MAGIC, sizeof(header.magic)) != 0)
+        throw fail("not a maze snapshot");
+    if (header.version != MazeSnapshotHeader::VERSION)
+        throw fail("unsupported snapshot version");
+    if (header.endianTag != MazeSnapshotHeader::ENDIAN_TAG)
+        throw fail("snapshot was written with a different byte order");
+    if (header.width == 0 || header.height == 0 || header.tileShift >= 16)
+        throw fail("corrupted dimensions");
+    if (header.payloadSize != Grid::StorageSize(header.width, header.height, header.tileShift) * sizeof(Cell))
+        throw fail("payload size does not match dimensions");
+    if (header.payloadOffset % alignof(Cell) != 0 || header.payloadOffset < sizeof(header) ||
+        header.payloadOffset > file->size() || file->size() - header.payloadOffset < header.payloadSize)
+        throw fail("file is truncated");
+    if (verifyChecksum && Checksum(file->data() + header.payloadOffset, header.payloadSize) != header.checksum)
+        throw fail("checksum mismatch");
+
+    Grid grid = Grid::Adopt(header.width, header.height, header.tileShift, std::move(file), header.payloadOffset);
+    if (!hasSealedBorder(grid))
+        throw fail("a passage leads off the grid");
+    return Maze::FromGrid(std::move(grid), header.seed);
+}
+
+uint64_t MazeSnapshot::Checksum(const void* data, size_t size)
+{
+    SnapshotChecksum checksum;
+    checksum.update(data, size);
+    return checksum.digest();
+}
+
+// FNV-1a over 64-bit words, followed by the tail bytes - good enough to catch corruption, not an integrity hash
+static constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+void SnapshotChecksum::mix(uint64_t word)
+{
+    m_hash = (m_hash ^ word) * FNV_PRIME;
+    m_hash ^= m_hash >> 32;
+}
+
+void SnapshotChecksum::update(const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    // complete a word left over from the previous update first
+    if (m_pendingSize > 0)
+    {
+        const size_t take = std::min(size, sizeof(uint64_t) - m_pendingSize);
+        std::memcpy(m_pending + m_pendingSize, bytes, take);
+        m_pendingSize += take;
+        bytes += take;
+        size -= take;
+
+        if (m_pendingSize < sizeof(uint64_t))
+            return;
+
+        uint64_t word;
+        std::memcpy(&word, m_pending, sizeof(word));
+        mix(word);
+        m_pendingSize = 0;
+    }
+
+    for (; size >= sizeof(uint64_t); bytes += sizeof(uint64_t), size -= sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        mix(word);
+    }
+
+    std::memcpy(m_pending + m_pendingSize, bytes, size);
+    m_pendingSize += size;
+}
+
+uint64_t SnapshotChecksum::digest() const
+{
+    uint64_t hash = m_hash;
+    for (size_t i = 0; i < m_pendingSize; i++)
+    {
+        hash = (hash ^ m_pending[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+void SnapshotRowSink::begin(size_t width, size_t height, uint32_t seed)
+{
+    m_file.open(m_path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        throw std::runtime_error("SnapshotRowSink: cannot open " + m_path.string() + " for writing");
+
+    std::memcpy(m_header.magic, MazeSnapshotHeader::MAGIC, sizeof(m_header.magic));
+    m_header.version = MazeSnapshotHeader::VERSION;
+    m_header.endianTag = MazeSnapshotHeader::ENDIAN_TAG;
+    m_header.width = width;
+    m_header.height = height;
+    m_header.seed = seed;
+    m_header.tileShift = 0;
+    m_header.payloadOffset = MazeSnapshotHeader::PAYLOAD_ALIGNMENT;
+    m_header.payloadSize = Grid::StorageSize(width, height, 0) * sizeof(Cell);
+    m_checksum = SnapshotChecksum();
+
+    // placeholder header, rewritten by end()
+    std::vector<char> padding(m_header.payloadOffset, 0);
+    m_file.write(padding.data(), padding.size());
+
+    m_buffer.assign(width + 2, Cell());
+    writeSentinelRow();
+}
+
+void SnapshotRowSink::write(const void* data, size_t size)
+{
+    m_file.write(static_cast<const char*>(data), size);
+    m_checksum.update(data, size);
+}
+
+void SnapshotRowSink::writeSentinelRow()
+{
+    Cell sentinel;
+    sentinel.setVisited();
+    std::fill(m_buffer.begin(), m_buffer.end(), sentinel);
+    write(m_buffer.data(), m_buffer.size() * sizeof(Cell));
+}
+
+void SnapshotRowSink::consumeRow(size_t, const Cell* row)
+{
+    // same layout as a row-major Grid: one sentinel cell on each side of the row
+    std::copy(row, row + m_header.width, m_buffer.begin() + 1);
+    write(m_buffer.data(), m_buffer.size() * sizeof(Cell));
+}
+
+void SnapshotRowSink::end()
+{
+    writeSentinelRow();
+
+    m_header.checksum = m_checksum.digest();
+    m_file.seekp(0);
+    m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    m_file.close();
+
+    if (!m_file)
+        throw std::runtime_error("SnapshotRowSink: failed writing " + m_path.string());
+}
+
+std::shared_ptr<Maze> SnapshotMazeLoader::createMaze(size_t width, size_t height, uint32_t) const
+{
+    std::shared_ptr<Maze> maze = MazeSnapshot::Load(m_path, m_verifyChecksum);
+
+    if ((width != 0 && width != maze->getWidth()) || (height != 0 && height != maze->getHeight()))
+    {
+        throw std::runtime_error("SnapshotMazeLoader: " + m_path.string() + " holds a " +
+            std::to_string(maze->getWidth()) + "x" + std::to_string(maze->getHeight()) + " maze");
+    }
+    return maze;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+#include "Maze.h"
+#include "MazeStream.h"
+
+/**
+ * @brief Versioned binary maze file: a fixed header followed by the raw Grid buffer
+ *
+ * The payload is the grid's cell buffer byte for byte (sentinel border and tiling included) and starts
+ * at a page-aligned offset, so loading is a memory mapping plus header validation - cells are never parsed
+ * or copied. Files use the native byte order, ENDIAN_TAG rejects files written on a foreign one.
+ */
+struct MazeSnapshotHeader
+{
+    static constexpr char MAGIC[8] = { 'L', 'A', 'B', 'Y', 'M', 'A', 'Z', 'E' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr uint32_t ENDIAN_TAG = 0x01020304;
+    static constexpr uint64_t PAYLOAD_ALIGNMENT = 4096;
+
+    char magic[8];
+    uint32_t version;
+    uint32_t endianTag;
+    uint64_t width;
+    uint64_t height;
+    uint32_t seed;
+    uint32_t tileShift;       // Grid layout of the payload, 0 for row-major
+    uint64_t payloadOffset;   // from the start of the file
+    uint64_t payloadSize;     // in bytes
+    uint64_t checksum;        // MazeSnapshot::Checksum of the payload
+};
+
+class MazeSnapshot
+{
+public:
+    MazeSnapshot() = delete;
+    ~MazeSnapshot() = delete;
+
+    static void Save(const Maze& maze, const std::filesystem::path& path);
+
+    /**
+     * @brief Maps a snapshot file and wraps it into a Maze
+     *
+     * The mapping is copy-on-write: walls broken afterwards never reach the file.
+     * Throws std::runtime_error if the file is not a valid snapshot. The border is always checked for
+     * passages leading off the grid, even without verifyChecksum.
+     *
+     * @param verifyChecksum checksumming reads the whole payload once, turn it off to keep
+     * the load lazy for mazes much larger than memory
+     */
+    static std::shared_ptr<Maze> Load(const std::filesystem::path& path, bool verifyChecksum = true);
+
+    static uint64_t Checksum(const void* data, size_t size);
+};
+
+/**
+ * @brief Incremental form of MazeSnapshot::Checksum, for payloads that are produced piece by piece
+ */
+class SnapshotChecksum
+{
+public:
+    void update(const void* data, size_t size);
+    uint64_t digest() const;
+
+private:
+    void mix(uint64_t word);
+
+private:
+    uint64_t m_hash = 0xcbf29ce484222325ull;
+    uint8_t m_pending[sizeof(uint64_t)] = {};
+    size_t m_pendingSize = 0;
+};
+
+/**
+ * @brief Streams generated rows straight into a row-major snapshot file
+ *
+ * The header is written last, once the checksum is known, so the maze never has to exist in memory.
+ */
+class SnapshotRowSink : public MazeRowSink
+{
+public:
+    SnapshotRowSink(const std::filesystem::path& path)
+        : m_path(path)
+    {
+    }
+
+    virtual void begin(size_t width, size_t height, uint32_t seed) override;
+    virtual void consumeRow(size_t y, const Cell* row) override;
+    virtual void end() override;
+
+private:
+    void writeSentinelRow();
+    void write(const void* data, size_t size);
+
+private:
+    std::filesystem::path m_path;
+    std::ofstream m_file;
+    MazeSnapshotHeader m_header{};
+    SnapshotChecksum m_checksum;
+    std::vector<Cell> m_buffer;
+};
+
+/**
+ * @brief MazeFactory that starts from a snapshot file instead of generating
+ *
+ * Width and height of 0 accept whatever the file holds, anything else must match it. The seed argument is
+ * ignored: the maze keeps the seed recorded in the file.
+ */
+class SnapshotMazeLoader : public MazeFactory
+{
+public:
+    SnapshotMazeLoader(const std::filesystem::path& path, bool verifyChecksum = true)
+        : m_path(path)
+        , m_verifyChecksum(verifyChecksum)
+    {
+    }
+
+    virtual std::shared_ptr<Maze> createMaze(size_t width, size_t height, uint32_t seed = 0) const override;
+
+private:
+    std::filesystem::path m_path;
+    bool m_verifyChecksum;
+};
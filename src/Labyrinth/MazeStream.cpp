@@ -0,0 +1,213 @@
+#include "MazeStream.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "utility/RandomGenerator.h"
+
+void GridRowSink::begin(size_t width, size_t height, uint32_t)
+{
+    if (width != m_grid.getWidth() || height != m_grid.getHeight())
+        throw std::invalid_argument("GridRowSink: grid dimensions do not match the maze");
+}
+
+void GridRowSink::consumeRow(size_t y, const Cell* row)
+{
+    for (size_t x = 0; x < m_grid.getWidth(); x++)
+    {
+        m_grid.cell(x, y) = row[x];
+    }
+}
+
+void BitMazeRowSink::begin(size_t width, size_t height, uint32_t)
+{
+    if (width != m_maze.getWidth() || height != m_maze.getHeight())
+        throw std::invalid_argument("BitMazeRowSink: maze dimensions do not match");
+}
+
+void BitMazeRowSink::consumeRow(size_t y, const Cell* row)
+{
+    BitMaze::word_type* east = m_maze.eastRow(y);
+    BitMaze::word_type* south = m_maze.southRow(y);
+
+    for (size_t x = 0; x < m_maze.getWidth(); x++)
+    {
+        const BitMaze::word_type bit = BitMaze::word_type(1) << (x % BitMaze::WORD_BITS);
+        if (row[x].hasPath(Direction::EAST))
+            east[x / BitMaze::WORD_BITS] |= bit;
+        if (row[x].hasPath(Direction::SOUTH))
+            south[x / BitMaze::WORD_BITS] |= bit;
+    }
+}
+
+void PbmRowSink::begin(size_t width, size_t height, uint32_t)
+{
+    m_file.open(m_path, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        throw std::runtime_error("PbmRowSink: cannot open " + m_path.string() + " for writing");
+
+    m_width = width;
+    m_line.assign((2 * width + 1 + 7) / 8, 0);
+    m_file << "P4\n" << (2 * width + 1) << " " << (2 * height + 1) << "\n";
+}
+
+void PbmRowSink::setPixel(size_t x, bool wall)
+{
+    // P4 packs pixels MSB first, a set bit is black
+    if (wall)
+        m_line[x / 8] |= uint8_t(0x80 >> (x % 8));
+}
+
+void PbmRowSink::flushLine()
+{
+    m_file.write(reinterpret_cast<const char*>(m_line.data()), m_line.size());
+    std::fill(m_line.begin(), m_line.end(), 0);
+}
+
+void PbmRowSink::consumeRow(size_t, const Cell* row)
+{
+    // wall line above the row: corners are always walls
+    for (size_t x = 0; x < m_width; x++)
+    {
+        setPixel(2 * x, true);
+        setPixel(2 * x + 1, !row[x].hasPath(Direction::NORTH));
+    }
+    setPixel(2 * m_width, true);
+    flushLine();
+
+    // the row itself
+    for (size_t x = 0; x < m_width; x++)
+    {
+        setPixel(2 * x, !row[x].hasPath(Direction::WEST));
+    }
+    setPixel(2 * m_width, true);
+    flushLine();
+}
+
+void PbmRowSink::end()
+{
+    for (size_t x = 0; x < 2 * m_width + 1; x++)
+    {
+        setPixel(x, true);
+    }
+    flushLine();
+    m_file.close();
+
+    if (!m_file)
+        throw std::runtime_error("PbmRowSink: failed writing " + m_path.string());
+}
+
+void EllerMazeCreator::Generate(size_t width, size_t height, uint32_t seed, MazeRowSink& sink)
+{
+    seed = RandomGenerator::resolveSeed(seed);
+    sink.begin(width, height, seed);
+
+    Xoshiro256 rng(seed);
+    auto coin = [&]() { return (rng() >> 63) == 1; };
+
+    // Set ids are recycled, so they always fit into [0, width): every id is either
+    // the set of some cell in the current row or free. Sets merge through a union-find over ids.
+    std::vector<uint32_t> set(width);
+    std::vector<uint32_t> parent(width);
+    std::vector<uint32_t> remaining(width); // cells of a set not yet decided on during the vertical pass
+    std::vector<bool> wentDown(width);      // per set, whether some cell already carved south
+    std::vector<bool> used(width);
+    std::vector<Cell> row(width);
+    for (Cell& cell : row)
+        cell.setVisited();
+
+    auto find = [&](uint32_t id)
+    {
+        while (parent[id] != id)
+        {
+            parent[id] = parent[parent[id]];
+            id = parent[id];
+        }
+        return id;
+    };
+
+    // first row: every cell is its own set
+    std::iota(set.begin(), set.end(), 0);
+
+    for (size_t y = 0; y < height; y++)
+    {
+        const bool lastRow = y + 1 == height;
+        std::iota(parent.begin(), parent.end(), 0);
+
+        // horizontal pass - join neighbors of different sets at random, the last row joins all of them
+        for (size_t x = 0; x + 1 < width; x++)
+        {
+            uint32_t a = find(set[x]);
+            uint32_t b = find(set[x + 1]);
+            if (a != b && (lastRow || coin()))
+            {
+                parent[b] = a;
+                row[x].breakWall(Direction::EAST);
+                row[x + 1].breakWall(Direction::WEST);
+            }
+        }
+
+        if (lastRow)
+        {
+            sink.consumeRow(y, row.data());
+            break;
+        }
+
+        // vertical pass - every set carves south at least once, so it stays connected to the rest
+        std::fill(remaining.begin(), remaining.end(), 0);
+        std::fill(wentDown.begin(), wentDown.end(), false);
+        for (size_t x = 0; x < width; x++)
+        {
+            set[x] = find(set[x]);
+            ++remaining[set[x]];
+        }
+
+        std::fill(used.begin(), used.end(), false);
+        for (size_t x = 0; x < width; x++)
+        {
+            uint32_t id = set[x];
+            bool last = --remaining[id] == 0;
+            if ((last && !wentDown[id]) || coin())
+            {
+                wentDown[id] = true;
+                used[id] = true;
+                row[x].breakWall(Direction::SOUTH);
+            }
+        }
+
+        sink.consumeRow(y, row.data());
+
+        // next row - cells below a passage keep their set, the others take a free id
+        uint32_t freeId = 0;
+        for (size_t x = 0; x < width; x++)
+        {
+            bool down = row[x].hasPath(Direction::SOUTH);
+            row[x] = Cell();
+            row[x].setVisited();
+
+            if (down)
+            {
+                row[x].breakWall(Direction::NORTH);
+                continue;
+            }
+
+            while (used[freeId])
+                ++freeId;
+            used[freeId] = true;
+            set[x] = freeId;
+        }
+    }
+
+    sink.end();
+}
+
+std::shared_ptr<Maze> EllerMazeCreator::createMaze(size_t width, size_t height, uint32_t seed) const
+{
+    seed = RandomGenerator::resolveSeed(seed);
+    Grid grid(width, height);
+    GridRowSink sink(grid);
+    Generate(width, height, seed, sink);
+
+    return Maze::FromGrid(std::move(grid), seed);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "Maze.h"
+#include "BitMaze.h"
+
+/**
+ * @brief Receiver of a maze produced one row at a time, north to south
+ *
+ * A row is handed over once all of its passages are final and is not referenced afterwards,
+ * so sinks that write elsewhere (files, bitplanes) keep the whole pipeline at O(width) memory.
+ */
+class MazeRowSink
+{
+public:
+    MazeRowSink() = default;
+    virtual ~MazeRowSink() = default;
+
+    virtual void begin([[maybe_unused]] size_t width, [[maybe_unused]] size_t height, [[maybe_unused]] uint32_t seed) {}
+    // width cells of row y, west to east
+    virtual void consumeRow(size_t y, const Cell* row) = 0;
+    virtual void end() {}
+};
+
+// Writes rows into an existing Grid (heap or mapped) of the same dimensions
+class GridRowSink : public MazeRowSink
+{
+public:
+    GridRowSink(Grid& grid)
+        : m_grid(grid)
+    {
+    }
+
+    virtual void begin(size_t width, size_t height, uint32_t seed) override;
+    virtual void consumeRow(size_t y, const Cell* row) override;
+
+private:
+    Grid& m_grid;
+};
+
+// Packs rows into the east/south bitplanes of a BitMaze of the same dimensions
+class BitMazeRowSink : public MazeRowSink
+{
+public:
+    BitMazeRowSink(BitMaze& maze)
+        : m_maze(maze)
+    {
+    }
+
+    virtual void begin(size_t width, size_t height, uint32_t seed) override;
+    virtual void consumeRow(size_t y, const Cell* row) override;
+
+private:
+    BitMaze& m_maze;
+};
+
+/**
+ * @brief Exports the maze as a binary PBM (P4) image, one pixel per wall/cell like MazePrinter::PrintInConsole
+ */
+class PbmRowSink : public MazeRowSink
+{
+public:
+    PbmRowSink(const std::filesystem::path& path)
+        : m_path(path)
+    {
+    }
+
+    virtual void begin(size_t width, size_t height, uint32_t seed) override;
+    virtual void consumeRow(size_t y, const Cell* row) override;
+    virtual void end() override;
+
+private:
+    void setPixel(size_t x, bool wall);
+    void flushLine();
+
+private:
+    std::filesystem::path m_path;
+    std::ofstream m_file;
+    std::vector<uint8_t> m_line;
+    size_t m_width = 0;
+};
+
+/**
+ * @brief Perfect maze generator based on Eller's algorithm
+ *
+ * Rows are generated one at a time while only the set membership of the current row is kept,
+ * so the working state is O(width) no matter the height, and rows are streamed to a MazeRowSink.
+ * Draws come from a generator of its own seeded with seed, a random one if seed is 0.
+ */
+class EllerMazeCreator : public MazeFactory
+{
+public:
+    virtual std::shared_ptr<Maze> createMaze(size_t width, size_t height, uint32_t seed = 0) const override;
+
+    static void Generate(size_t width, size_t height, uint32_t seed, MazeRowSink& sink);
+};
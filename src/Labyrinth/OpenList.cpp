@@ -0,0 +1,78 @@
+#include "OpenList.h"
+
+#include <bit>
+
+void BucketOpenList::clear()
+{
+    for (Bucket& bucket : m_buckets)
+    {
+        bucket.items.clear();
+        bucket.head = 0;
+    }
+    m_size = 0;
+}
+
+void BucketOpenList::push(uint32_t index, uint32_t f)
+{
+    if (m_size == 0)
+    {
+        m_minF = f;
+        m_maxF = f;
+    }
+    else if (f < m_minF || f > m_maxF)
+    {
+        uint32_t lowF = std::min(f, m_minF);
+        uint32_t highF = std::max(f, m_maxF);
+        if (highF - lowF >= m_buckets.size())
+            grow(lowF, highF);
+        m_minF = lowF;
+        m_maxF = highF;
+    }
+
+    bucketFor(f).items.push_back(index);
+    ++m_size;
+}
+
+void BucketOpenList::settle()
+{
+    while (bucketFor(m_minF).empty())
+        ++m_minF;
+}
+
+uint32_t BucketOpenList::top()
+{
+    settle();
+    Bucket& bucket = bucketFor(m_minF);
+    return m_tieBreak == TieBreak::LIFO ? bucket.items.back() : bucket.items[bucket.head];
+}
+
+void BucketOpenList::pop()
+{
+    settle();
+    Bucket& bucket = bucketFor(m_minF);
+    if (m_tieBreak == TieBreak::LIFO)
+        bucket.items.pop_back();
+    else
+        ++bucket.head;
+
+    if (bucket.empty())
+    {
+        bucket.items.clear();
+        bucket.head = 0;
+    }
+    --m_size;
+}
+
+void BucketOpenList::grow(uint32_t lowF, uint32_t highF)
+{
+    std::vector<Bucket> old = std::move(m_buckets);
+    m_buckets = std::vector<Bucket>(std::bit_ceil(size_t(highF - lowF) + 1));
+
+    // re-home every pending entry, f values of old buckets are recovered from the old range
+    for (uint32_t f = m_minF; f <= m_maxF; f++)
+    {
+        Bucket& from = old[f & (old.size() - 1)];
+        Bucket& to = bucketFor(f);
+        to.items.insert(to.items.end(), from.items.begin() + from.head, from.items.end());
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Open list kinds a Pathfinder can run A* with
+ */
+enum class OpenListPolicy
+{
+    BINARY_HEAP, // O(log n) per operation, works for any heuristic
+    BUCKETS,     // O(1) per operation, for the integer f values of unit-cost searches
+};
+
+/**
+ * @brief Which of the nodes sharing the lowest f a bucket queue hands out first
+ */
+enum class TieBreak
+{
+    LIFO, // most recently pushed - dives towards the goal, usually fewer expansions on equal f
+    FIFO, // oldest first - breadth-first order within an f layer
+};
+
+/**
+ * @brief Binary min-heap of (f, node index) entries
+ */
+class HeapOpenList
+{
+public:
+    inline void clear() { m_entries.clear(); }
+    inline bool empty() const { return m_entries.empty(); }
+    inline size_t size() const { return m_entries.size(); }
+
+    inline void push(uint32_t index, uint32_t f)
+    {
+        m_entries.push_back({ f, index });
+        std::push_heap(m_entries.begin(), m_entries.end(), std::greater<Entry>());
+    }
+    inline uint32_t top() const { return m_entries.front().index; }
+    inline uint32_t topF() const { return m_entries.front().f; }
+    inline void pop()
+    {
+        std::pop_heap(m_entries.begin(), m_entries.end(), std::greater<Entry>());
+        m_entries.pop_back();
+    }
+
+private:
+    struct Entry
+    {
+        uint32_t f;
+        uint32_t index;
+
+        inline bool operator>(const Entry& rhs) const { return f > rhs.f; }
+    };
+
+    std::vector<Entry> m_entries;
+};
+
+/**
+ * @brief Dial's bucket queue over integer f values
+ *
+ * Buckets form a ring indexed by f modulo its size. With unit edge costs and a consistent heuristic
+ * the open f values span at most 3 consecutive values, so the ring stays tiny; a wider spread (e.g. an
+ * inconsistent heuristic) grows the ring instead of breaking the queue.
+ */
+class BucketOpenList
+{
+public:
+    BucketOpenList(TieBreak tieBreak = TieBreak::LIFO)
+        : m_tieBreak(tieBreak)
+        , m_buckets(INITIAL_BUCKETS)
+    {
+    }
+
+    inline void setTieBreak(TieBreak tieBreak) { m_tieBreak = tieBreak; }
+
+    void clear();
+    inline bool empty() const { return m_size == 0; }
+    inline size_t size() const { return m_size; }
+
+    void push(uint32_t index, uint32_t f);
+    // both require !empty()
+    uint32_t top();
+    inline uint32_t topF() { settle(); return m_minF; }
+    void pop();
+
+private:
+    struct Bucket
+    {
+        std::vector<uint32_t> items;
+        size_t head = 0; // FIFO read position, items before it are consumed
+
+        inline bool empty() const { return head == items.size(); }
+    };
+
+    static constexpr size_t INITIAL_BUCKETS = 4;
+
+    inline Bucket& bucketFor(uint32_t f) { return m_buckets[f & (m_buckets.size() - 1)]; }
+    // moves m_minF forward to the first non-empty bucket
+    void settle();
+    void grow(uint32_t lowF, uint32_t highF);
+
+private:
+    TieBreak m_tieBreak;
+    std::vector<Bucket> m_buckets; // power of two sized ring
+    uint32_t m_minF = 0;
+    uint32_t m_maxF = 0;
+    size_t m_size = 0;
+};
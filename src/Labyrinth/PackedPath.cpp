@@ -0,0 +1,24 @@
+#include "PackedPath.h"
+
+PackedPath PackedPath::FromSteps(const Vec2i& start, std::span<const Vec2i> steps)
+{
+    PackedPath path(start);
+    path.m_words.reserve((steps.size() + STEPS_PER_WORD - 1) / STEPS_PER_WORD);
+
+    Vec2i from = start;
+    for (const Vec2i& to : steps)
+    {
+        path.push(CodeOf(from, to));
+        from = to;
+    }
+    return path;
+}
+
+std::vector<Vec2i> PackedPath::unpack() const
+{
+    std::vector<Vec2i> steps;
+    steps.reserve(m_size);
+    for (Cursor cursor(*this); !cursor.done(); )
+        steps.push_back(cursor.next());
+    return steps;
+}
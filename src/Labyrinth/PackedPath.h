@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "utility/Vec2.h"
+
+/**
+ * @brief A path stored as 2-bit step directions from a start cell, 32 steps per 64-bit word
+ *
+ * Codes follow the N, E, S, W order of OpenMaskNeighbors::DELTAS. A step costs 2 bits instead of the
+ * 8 bytes of a Vec2i, and it is read front to back through a Cursor in O(1) per step, without erasing.
+ */
+class PackedPath
+{
+public:
+    static constexpr size_t STEPS_PER_WORD = 32;
+    static constexpr Vec2i DELTAS[4] = { Vec2i(0, -1), Vec2i(1, 0), Vec2i(0, 1), Vec2i(-1, 0) };
+
+    /**
+     * @brief Walks a PackedPath one step at a time; stays valid while the path is not modified
+     */
+    class Cursor
+    {
+    public:
+        Cursor() = default;
+        Cursor(const PackedPath& path)
+            : m_path(&path)
+            , m_pos(path.getStart())
+        {
+        }
+
+        inline bool done() const { return !m_path || m_index == m_path->size(); }
+        inline size_t remaining() const { return m_path ? m_path->size() - m_index : 0; }
+        // cell reached by the steps taken so far
+        inline const Vec2i& getPos() const { return m_pos; }
+        // takes the next step and returns the cell it leads to, must not be called once done()
+        inline const Vec2i& next()
+        {
+            const Vec2i& delta = DELTAS[m_path->code(m_index++)];
+            m_pos = Vec2i(m_pos.x + delta.x, m_pos.y + delta.y);
+            return m_pos;
+        }
+
+    private:
+        const PackedPath* m_path = nullptr;
+        size_t m_index = 0;
+        Vec2i m_pos = Vec2i(0);
+    };
+
+public:
+    PackedPath() = default;
+    explicit PackedPath(const Vec2i& start)
+        : m_start(start)
+    {
+    }
+
+    // packs a Pathfinder::find style path (start excluded), every step must be to a 4-neighbor
+    static PackedPath FromSteps(const Vec2i& start, std::span<const Vec2i> steps);
+    std::vector<Vec2i> unpack() const;
+
+    inline const Vec2i& getStart() const { return m_start; }
+    inline size_t size() const { return m_size; }
+    inline bool empty() const { return m_size == 0; }
+    inline Cursor cursor() const { return Cursor(*this); }
+
+    inline uint8_t code(size_t i) const { return (m_words[i / STEPS_PER_WORD] >> (2 * (i % STEPS_PER_WORD))) & 0b11; }
+    // direction code of the step from -> to
+    static inline uint8_t CodeOf(const Vec2i& from, const Vec2i& to)
+    {
+        // N (0,-1) -> 0, E (1,0) -> 1, S (0,1) -> 2, W (-1,0) -> 3
+        const int32_t dx = to.x - from.x;
+        const int32_t dy = to.y - from.y;
+        return static_cast<uint8_t>(dx != 0 ? 2 - dx : 1 + dy);
+    }
+
+    inline void push(uint8_t code)
+    {
+        if (m_size % STEPS_PER_WORD == 0)
+            m_words.push_back(0);
+        m_words.back() |= static_cast<uint64_t>(code) << (2 * (m_size % STEPS_PER_WORD));
+        ++m_size;
+    }
+    // for writers that know the length up front and fill in any order, all codes start as 0
+    inline void resize(size_t steps)
+    {
+        m_words.assign((steps + STEPS_PER_WORD - 1) / STEPS_PER_WORD, 0);
+        m_size = steps;
+    }
+    inline void set(size_t i, uint8_t code) { m_words[i / STEPS_PER_WORD] |= static_cast<uint64_t>(code) << (2 * (i % STEPS_PER_WORD)); }
+
+    inline void clear(const Vec2i& start)
+    {
+        m_start = start;
+        m_words.clear();
+        m_size = 0;
+    }
+
+private:
+    Vec2i m_start = Vec2i(0);
+    std::vector<uint64_t> m_words;
+    size_t m_size = 0;
+};
@@ -0,0 +1,123 @@
+#include "ParallelMaze.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include "MazeCarver.h"
+#include "utility/RandomGenerator.h"
+
+namespace
+{
+    // stream ids keep the tile streams and the merge stream apart for the same seed
+    enum StreamKind : uint32_t
+    {
+        TILE_STREAM = 0,
+        MERGE_STREAM = 1,
+    };
+
+    Xoshiro256 makeStream(uint32_t seed, StreamKind kind, uint64_t index)
+    {
+        return Xoshiro256::stream(seed, (static_cast<uint64_t>(kind) << 63) | index);
+    }
+
+    struct TileEdge
+    {
+        size_t a;
+        size_t b;
+        bool horizontal; // b is east of a, otherwise south
+    };
+}
+
+ParallelMazeCreator::ParallelMazeCreator(size_t tileSize, std::shared_ptr<ThreadPool> pool)
+    : m_tileSize(std::max<size_t>(tileSize, 1))
+    , m_pool(pool ? std::move(pool) : std::make_shared<ThreadPool>())
+{
+}
+
+void ParallelMazeCreator::Generate(Grid& grid, uint32_t seed) const
+{
+    const size_t tilesX = (grid.getWidth() + m_tileSize - 1) / m_tileSize;
+    const size_t tilesY = (grid.getHeight() + m_tileSize - 1) / m_tileSize;
+
+    auto tileRegion = [&](size_t tile)
+    {
+        size_t tx = tile % tilesX;
+        size_t ty = tile / tilesX;
+        return GridRegion{
+            tx * m_tileSize,
+            ty * m_tileSize,
+            std::min((tx + 1) * m_tileSize, grid.getWidth()),
+            std::min((ty + 1) * m_tileSize, grid.getHeight()),
+        };
+    };
+
+    // carve phase - tiles are disjoint, so workers never touch the same cell
+    m_pool->parallelFor(tilesX * tilesY, [&](size_t tile)
+    {
+        Xoshiro256 rng = makeStream(seed, TILE_STREAM, tile);
+        CarveBacktracker(grid, tileRegion(tile), [&](size_t n) { return rng.bounded(n); });
+    });
+
+    // merge phase - randomized Kruskal over tile borders, O(tiles) and serial
+    std::vector<TileEdge> edges;
+    edges.reserve(2 * tilesX * tilesY);
+    for (size_t ty = 0; ty < tilesY; ty++)
+    {
+        for (size_t tx = 0; tx < tilesX; tx++)
+        {
+            size_t tile = ty * tilesX + tx;
+            if (tx + 1 < tilesX)
+                edges.push_back({ tile, tile + 1, true });
+            if (ty + 1 < tilesY)
+                edges.push_back({ tile, tile + tilesX, false });
+        }
+    }
+
+    Xoshiro256 rng = makeStream(seed, MERGE_STREAM, 0);
+    std::shuffle(edges.begin(), edges.end(), rng);
+
+    std::vector<size_t> parent(tilesX * tilesY);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&](size_t tile)
+    {
+        while (parent[tile] != tile)
+        {
+            parent[tile] = parent[parent[tile]];
+            tile = parent[tile];
+        }
+        return tile;
+    };
+
+    for (const TileEdge& edge : edges)
+    {
+        size_t a = find(edge.a);
+        size_t b = find(edge.b);
+        if (a == b)
+            continue;
+        parent[b] = a;
+
+        // open one random wall along the shared border
+        GridRegion region = tileRegion(edge.a);
+        size_t span = edge.horizontal ? region.getHeight() : region.getWidth();
+        size_t offset = rng.bounded(span);
+
+        Direction dir = edge.horizontal ? Direction::EAST : Direction::SOUTH;
+        size_t x = edge.horizontal ? region.x1 - 1 : region.x0 + offset;
+        size_t y = edge.horizontal ? region.y0 + offset : region.y1 - 1;
+        Vec2i npos = Vec2i(static_cast<int32_t>(x), static_cast<int32_t>(y)) + Vec2i::FromDirection(dir);
+
+        grid.cell(x, y).breakWall(dir);
+        grid.cell(npos.x, npos.y).breakWall(getOpposite(dir));
+    }
+}
+
+std::shared_ptr<Maze> ParallelMazeCreator::createMaze(size_t width, size_t height, uint32_t seed) const
+{
+    // seed 0 asks for a random one, like the other factories
+    seed = RandomGenerator::resolveSeed(seed);
+
+    Grid grid(width, height);
+    Generate(grid, seed);
+    return Maze::FromGrid(std::move(grid), seed);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "Maze.h"
+#include "utility/ThreadPool.h"
+
+/**
+ * @brief Multi-threaded perfect maze generator
+ *
+ * The grid is split into square tiles that are carved concurrently, each with the recursive backtracker
+ * and its own RNG stream derived from (seed, tile index). The tiles are then joined by a randomized
+ * Kruskal over the tile adjacency graph: each accepted tile edge opens one random wall on the shared
+ * border, so the result is a spanning tree of spanning trees - a perfect maze.
+ *
+ * Nothing depends on which thread carves which tile, so a seed produces the same maze for any thread count.
+ */
+class ParallelMazeCreator : public MazeFactory
+{
+public:
+    static constexpr size_t DEFAULT_TILE_SIZE = 256;
+
+public:
+    ParallelMazeCreator(size_t tileSize = DEFAULT_TILE_SIZE, std::shared_ptr<ThreadPool> pool = nullptr);
+    virtual ~ParallelMazeCreator() = default;
+
+    virtual std::shared_ptr<Maze> createMaze(size_t width, size_t height, uint32_t seed = 0) const override;
+
+    // carves a freshly constructed (all walls) grid, heap or mapped
+    void Generate(Grid& grid, uint32_t seed) const;
+
+    inline ThreadPool& GetThreadPool() const { return *m_pool; }
+
+private:
+    size_t m_tileSize;
+    std::shared_ptr<ThreadPool> m_pool;
+};
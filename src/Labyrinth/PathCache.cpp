@@ -0,0 +1,81 @@
+#include "PathCache.h"
+
+PathCache::PathCache(const std::shared_ptr<Pathfinder>& pathfinder, const std::shared_ptr<Maze>& maze, size_t capacity)
+    : m_pathfinder(pathfinder)
+    , m_maze(maze)
+    , m_capacity(std::max<size_t>(capacity, 1))
+{
+}
+
+void PathCache::clear()
+{
+    m_entries.clear();
+    m_index.clear();
+}
+
+bool PathCache::isStillShortest(const Entry& entry) const
+{
+    const auto changes = m_maze->getJournal().changesSince(entry.version);
+    if (!changes)
+        return false;
+
+    const Vec2i& start = entry.key.start;
+    const Vec2i& goal = entry.key.goal;
+    // an unreachable goal may have become reachable through any opened wall
+    if (entry.path.empty() && start != goal)
+        return false;
+
+    const uint32_t length = static_cast<uint32_t>(entry.path.size());
+    for (const MazeChange& change : *changes)
+    {
+        // a path through the new passage is at least as long as the taxicab detour via both of its ends
+        const Vec2i& lhs = change.pos;
+        const Vec2i rhs = change.pos + change.delta;
+        const uint32_t through = std::min(Vec2i::Manhattan(start, lhs) + Vec2i::Manhattan(rhs, goal),
+                                          Vec2i::Manhattan(start, rhs) + Vec2i::Manhattan(lhs, goal)) + 1;
+        if (through < length)
+            return false;
+    }
+    return true;
+}
+
+const std::vector<Vec2i>& PathCache::invoke(const Vec2i& start, const Vec2i& goal)
+{
+    const uint64_t version = m_maze->getVersion();
+    const Key key = { start, goal };
+
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+    {
+        Entry& entry = *it->second;
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        if (entry.version == version)
+        {
+            ++m_hits;
+            return entry.path;
+        }
+        if (isStillShortest(entry))
+        {
+            ++m_hits;
+            ++m_revalidations;
+            entry.version = version;
+            return entry.path;
+        }
+
+        ++m_misses;
+        entry.version = version;
+        entry.path = m_pathfinder->invoke(start, goal, Vec2i::Manhattan);
+        return entry.path;
+    }
+
+    ++m_misses;
+    if (m_entries.size() >= m_capacity)
+    {
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+    m_entries.push_front({ key, version, m_pathfinder->invoke(start, goal, Vec2i::Manhattan) });
+    m_index.emplace(key, m_entries.begin());
+    return m_entries.front().path;
+}
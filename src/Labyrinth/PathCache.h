@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Maze.h"
+#include "Pathfinding.h"
+
+/**
+ * @brief LRU cache of shortest paths in front of a Pathfinder, keyed by endpoints and validated against the maze version
+ *
+ * Walls only ever open between regenerations, so a cached path stays walkable; it only goes stale when
+ * a new passage could make a shorter one. For each wall opened since an entry was validated (read from
+ * the maze journal) the cache checks whether going through it could possibly beat the cached length -
+ * Manhattan distances to its two endpoints give a lower bound - and re-runs the search only then.
+ * Entries older than the changes the journal still remembers, e.g. after a regeneration, are recomputed.
+ * The cache does not subscribe to the journal, so it never holds back its compaction.
+ */
+class PathCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+public:
+    PathCache(const std::shared_ptr<Pathfinder>& pathfinder, const std::shared_ptr<Maze>& maze, size_t capacity = DEFAULT_CAPACITY);
+    ~PathCache() = default;
+
+    // Pathfinder::invoke through the cache; the reference stays valid until the next call
+    const std::vector<Vec2i>& invoke(const Vec2i& start, const Vec2i& goal);
+
+    void clear();
+
+    inline size_t getHits() const { return m_hits; }
+    inline size_t getMisses() const { return m_misses; }
+    // hits that needed a check against opened walls first
+    inline size_t getRevalidations() const { return m_revalidations; }
+    inline double getHitRate() const { return m_hits + m_misses ? static_cast<double>(m_hits) / (m_hits + m_misses) : 0.0; }
+
+private:
+    struct Key
+    {
+        Vec2i start;
+        Vec2i goal;
+
+        inline bool operator==(const Key& rhs) const { return start == rhs.start && goal == rhs.goal; }
+    };
+
+    struct KeyHash
+    {
+        inline size_t operator()(const Key& key) const
+        {
+            const uint64_t start = (static_cast<uint64_t>(static_cast<uint32_t>(key.start.x)) << 32) | static_cast<uint32_t>(key.start.y);
+            const uint64_t goal = (static_cast<uint64_t>(static_cast<uint32_t>(key.goal.x)) << 32) | static_cast<uint32_t>(key.goal.y);
+            return std::hash<uint64_t>()(start * 0x9E3779B97F4A7C15ull ^ goal);
+        }
+    };
+
+    struct Entry
+    {
+        Key key;
+        uint64_t version;
+        std::vector<Vec2i> path;
+    };
+
+    // true if no wall opened since the entry's version can lead to a shorter path
+    bool isStillShortest(const Entry& entry) const;
+
+private:
+    std::shared_ptr<Pathfinder> m_pathfinder;
+    std::shared_ptr<Maze> m_maze;
+    size_t m_capacity;
+
+    // most recently used first
+    std::list<Entry> m_entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> m_index;
+
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    size_t m_revalidations = 0;
+};
@@ -0,0 +1,153 @@
+#include "PathOracle.h"
+
+#include <algorithm>
+
+PathOracle::PathOracle(const std::shared_ptr<Maze>& maze)
+    : m_maze(maze)
+    , m_width(maze->getWidth())
+{
+    build();
+}
+
+void PathOracle::build()
+{
+    const size_t size = m_maze->getWidth() * m_maze->getHeight();
+    m_version = m_maze->getVersion();
+    m_parent.assign(size, UINT32_MAX);
+    m_jump.resize(size);
+    m_depth.resize(size);
+
+    // a connected graph is a tree exactly when it has one edge less than it has cells
+    size_t edges = 0;
+    for (size_t y = 0; y < m_maze->getHeight(); y++)
+        for (size_t x = 0; x < m_maze->getWidth(); x++)
+        {
+            const Cell& cell = m_maze->cell(x, y);
+            edges += cell.hasPath(Direction::EAST) + cell.hasPath(Direction::SOUTH);
+        }
+
+    size_t reached = 0;
+    if (edges + 1 == size)
+    {
+        // breadth-first order visits parents before children, which the jump pointers rely on;
+        // m_jump doubles as the queue until each entry is overwritten with the real pointer
+        std::vector<uint32_t>& order = m_jump;
+        order[reached++] = 0;
+        m_parent[0] = 0;
+        m_depth[0] = 0;
+        for (size_t head = 0; head < reached; head++)
+        {
+            const uint32_t index = order[head];
+            const Vec2i pos = toPos(index);
+            OpenMaskNeighbors::forEach(m_maze->cell(pos.x, pos.y), pos, [&](const Vec2i& neighborPos)
+            {
+                const uint32_t neighbor = toIndex1D(neighborPos);
+                if (m_parent[neighbor] != UINT32_MAX)
+                    return;
+                m_parent[neighbor] = index;
+                m_depth[neighbor] = m_depth[index] + 1;
+                order[reached++] = neighbor;
+            });
+        }
+
+        if (reached == size)
+        {
+            std::vector<uint32_t> queue(order.begin(), order.end());
+            m_jump[0] = 0;
+            for (uint32_t index : queue)
+            {
+                // jump twice as far as the parent's jump when the parent's two jumps are equally long
+                const uint32_t parent = m_parent[index];
+                const uint32_t jump = m_jump[parent];
+                m_jump[index] = m_depth[parent] - m_depth[jump] == m_depth[jump] - m_depth[m_jump[jump]] && jump != parent
+                    ? m_jump[jump]
+                    : parent;
+            }
+        }
+    }
+
+    m_isTree = edges + 1 == size && reached == size;
+    if (m_isTree)
+    {
+        m_fallback.reset();
+    }
+    else
+    {
+        m_parent.clear();
+        m_jump.clear();
+        m_depth.clear();
+        m_parent.shrink_to_fit();
+        m_jump.shrink_to_fit();
+        m_depth.shrink_to_fit();
+        if (!m_fallback)
+            m_fallback = std::make_unique<Pathfinder>(m_maze);
+    }
+}
+
+uint32_t PathOracle::lca(uint32_t lhs, uint32_t rhs) const
+{
+    if (m_depth[lhs] < m_depth[rhs])
+        std::swap(lhs, rhs);
+
+    while (m_depth[lhs] > m_depth[rhs])
+        lhs = m_depth[m_jump[lhs]] >= m_depth[rhs] ? m_jump[lhs] : m_parent[lhs];
+
+    // at equal depth both jump pointers reach equally far
+    while (lhs != rhs)
+    {
+        if (m_jump[lhs] != m_jump[rhs])
+        {
+            lhs = m_jump[lhs];
+            rhs = m_jump[rhs];
+        }
+        else
+        {
+            lhs = m_parent[lhs];
+            rhs = m_parent[rhs];
+        }
+    }
+    return lhs;
+}
+
+uint32_t PathOracle::distance(const Vec2i& start, const Vec2i& goal)
+{
+    refresh();
+    if (!m_isTree)
+    {
+        if (start == goal)
+            return 0;
+        std::vector<Vec2i> path = m_fallback->invoke(start, goal, Vec2i::Manhattan);
+        return path.empty() ? UINT32_MAX : static_cast<uint32_t>(path.size());
+    }
+
+    const uint32_t lhs = toIndex1D(start);
+    const uint32_t rhs = toIndex1D(goal);
+    return m_depth[lhs] + m_depth[rhs] - 2 * m_depth[lca(lhs, rhs)];
+}
+
+std::vector<Vec2i> PathOracle::path(const Vec2i& start, const Vec2i& goal)
+{
+    refresh();
+    if (!m_isTree)
+        return m_fallback->invoke(start, goal, Vec2i::Manhattan);
+
+    const uint32_t from = toIndex1D(start);
+    const uint32_t to = toIndex1D(goal);
+    const uint32_t ancestor = lca(from, to);
+
+    std::vector<Vec2i> path;
+    path.reserve(m_depth[from] + m_depth[to] - 2 * m_depth[ancestor]);
+
+    // climb from the start up to the ancestor (included unless it is the start)...
+    for (uint32_t index = from; index != ancestor; )
+    {
+        index = m_parent[index];
+        path.push_back(toPos(index));
+    }
+    // ...then descend to the goal, which is the goal's climb reversed
+    const size_t descent = path.size();
+    for (uint32_t index = to; index != ancestor; index = m_parent[index])
+        path.push_back(toPos(index));
+    std::reverse(path.begin() + descent, path.end());
+    return path;
+}
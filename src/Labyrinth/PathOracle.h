@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Maze.h"
+#include "Pathfinding.h"
+
+/**
+ * @brief Answers path and distance queries on a perfect maze without searching
+ *
+ * A maze straight out of the generator is a spanning tree, so the path between two cells is unique:
+ * it climbs from both ends to their lowest common ancestor. build() roots the tree at (0, 0) and stores
+ * every cell's parent, depth and a single jump pointer (the skew-binary scheme of Myers' "jump lists"),
+ * which finds the LCA in O(log n) while keeping memory linear in the number of cells, unlike a binary
+ * lifting table.
+ *
+ * Queries check Maze::getVersion() and rebuild when the maze changed. Once breakWall() has introduced a
+ * cycle the maze is no longer a tree and queries fall back to a Pathfinder until it becomes one again.
+ */
+class PathOracle
+{
+public:
+    PathOracle(const std::shared_ptr<Maze>& maze);
+    ~PathOracle() = default;
+
+    // same shape as Pathfinder::find - start excluded, goal included, empty if unreachable
+    std::vector<Vec2i> path(const Vec2i& start, const Vec2i& goal);
+    // number of steps between the cells, UINT32_MAX if unreachable
+    uint32_t distance(const Vec2i& start, const Vec2i& goal);
+
+    // re-reads the maze, done implicitly by queries whenever its version changed
+    void build();
+    // false while the maze has cycles (or is disconnected) and queries go through the fallback search
+    inline bool isTree() { refresh(); return m_isTree; }
+
+private:
+    inline void refresh() { if (m_version != m_maze->getVersion()) build(); }
+    uint32_t lca(uint32_t lhs, uint32_t rhs) const;
+    inline constexpr uint32_t toIndex1D(const Vec2i& pos) const { return static_cast<uint32_t>(pos.y * m_width + pos.x); }
+    inline constexpr Vec2i toPos(uint32_t index) const { return Vec2i(index % m_width, index / m_width); }
+
+private:
+    std::shared_ptr<Maze> m_maze;
+    std::unique_ptr<Pathfinder> m_fallback;
+    size_t m_width;
+    uint64_t m_version = UINT64_MAX;
+    bool m_isTree = false;
+
+    std::vector<uint32_t> m_parent;
+    std::vector<uint32_t> m_jump;
+    std::vector<uint32_t> m_depth;
+};
@@ -1,102 +1,132 @@
 #include "Pathfinding.h"
 
+#include <algorithm>
 #include <memory>
 
-Pathfinder::Pathfinder(const std::shared_ptr<Maze>& maze)
-    : m_dimensions(Vec2i(maze->getWidth(), maze->getHeight()))
+void SearchWorkspace::begin(size_t size)
+{
+    if (m_nodes.size() < size)
+    {
+        m_nodes.resize(size);
+        m_stamps.resize(size, 0);
+    }
+    advance();
+    m_heap.clear();
+    m_buckets.clear();
+    expanded = 0;
+}
+
+void SearchWorkspace::advance()
+{
+    // each query uses two stamp values, on wrap-around old stamps could look current again
+    if (m_generation >= UINT32_MAX - 4)
+    {
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_generation = 0;
+    }
+    m_generation += 2;
+}
+
+Pathfinder::Pathfinder(const std::shared_ptr<Maze>& maze, OpenListPolicy policy, TieBreak tieBreak)
+    : m_policy(policy)
+    , m_dimensions(Vec2i(maze->getWidth(), maze->getHeight()))
     , m_maze(maze)
 {
+    setTieBreak(tieBreak);
 }
 
 void Pathfinder::reset()
 {
-    m_pathList.clear();
-    m_closedList.clear();
+    m_workspace.invalidate();
 }
 
 std::vector<Vec2i> Pathfinder::invoke(const Vec2i& start, const Vec2i& goal, const HeuristicFn& heuristic)
 {
-    static Vec2i neighbors[] = {
-        Vec2i{ 0, -1}, // NORTH
-        Vec2i{ 1,  0}, // EAST
-        Vec2i{ 0,  1}, // SOUTH
-        Vec2i{-1,  0}, // WEST
-    };
-
-    size_t sz = m_dimensions.x * m_dimensions.y;
-    reset();
-    m_pathList.resize(sz);
-    m_closedList.resize(sz, false);
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openList; // ...
-
-    m_pathList[toIndex1D(start)].parent = start; // assign start parent to start so we could recreate the path
-    openList.push(Node{ .pos = start }); // just assign pos, everything else is zero-initialized
-    Vec2i currentPos;
-
-    while (!openList.empty())
-    {
-        currentPos = openList.top().pos; // get node with least f value (g + h, to be exact)
-        if (currentPos == goal)
-        {
-            break;
-        }
-
-        // Mark node as closed one (as we just traversed it)
-        openList.pop();
-        m_closedList[toIndex1D(currentPos)] = true;
-
-        for (const Vec2i& v : neighbors)
-        {
-            Vec2i neighborPos = Vec2i(currentPos.x + v.x, currentPos.y + v.y);
-            size_t index = toIndex1D(neighborPos);
-
-            if (!isValid(neighborPos) || isWall((Vec2i) currentPos, (Vec2i) neighborPos) || m_closedList[index])
-                continue;
-
-            // we count new f, g and h
-            uint32_t g = m_pathList[toIndex1D(currentPos)].g + 1;
-            uint32_t h = heuristic(neighborPos, goal);
-            uint32_t f = g + h;
-
-            // if neighbors f == 0 (means we didn't traverse it yet) or is less than our current f
-            // then we assign our f to the node and push it into openList
-            uint32_t neighborF = m_pathList[index].g + m_pathList[index].h;
-            if (neighborF == 0 || f < neighborF)
-            {
-                Node n = { neighborPos, currentPos, g, h };
-                openList.push(n);
-                m_pathList[index] = n;
-            }
-        }
-    }
+    using ManhattanFn = uint32_t(*)(const Vec2i&, const Vec2i&);
 
-    return recreatePath(goal);
+    // the heuristic every caller passes gets the fully inlined kernel, anything else pays the indirect call
+    const ManhattanFn* fn = heuristic.target<ManhattanFn>();
+    if (fn && *fn == &Vec2i::Manhattan)
+        return find<ManhattanHeuristic>(start, goal);
+
+    return find(start, goal, FunctionHeuristic<HeuristicFn>{ heuristic });
 }
 
-std::vector<Vec2i> Pathfinder::recreatePath(const Vec2i& goal) const
+void Pathfinder::recreatePath(const Vec2i& goal, std::vector<Vec2i>& out) const
 {
-    std::vector<Vec2i> path;
+    const size_t first = out.size();
 
     Vec2 current = goal;
     size_t index = toIndex1D(current);
 
-    while (m_pathList[index].parent != current)
+    // the goal was never reached by the last query
+    if (!m_workspace.isSeen(index))
+        return;
+
+    while (m_workspace.node(index).parent != current)
     {
-        path.push_back(current);
-        current = m_pathList[index].parent;
+        out.push_back(current);
+        current = m_workspace.node(index).parent;
         index = toIndex1D(current);
     }
 
-    std::reverse(path.begin(), path.end());
-    return path;
+    std::reverse(out.begin() + first, out.end());
 }
 
-bool Pathfinder::isWall(const Vec2i& parent, const Vec2i& neighbor) const
+void Pathfinder::recreatePath(const Meeting& meeting, std::vector<Vec2i>& out) const
 {
-    // I get delta between vector neigbor and parent, based on which I will choose the direction
-    // Example: Parent = {0, 1} and Neighbor = {0, 2}. Then Delta = {0, 1}, which is Direction::SOUTH
-    Vec2i delta = Vec2i::Delta(neighbor, parent);
-    // now, when we got a direction, we can check if we can move from parent to neighbor
-    Cell& cell = (*m_maze)[parent.x][parent.y];
-    return !cell.hasPath((Direction) delta); // we are able to cast vec2 to direction due to vec2 operator()
-}
\ No newline at end of file
+    if (meeting.length == UINT32_MAX)
+        return;
+
+    // stitch: start..meetForward from the forward parents, then meetBackward..goal
+    out.reserve(out.size() + meeting.length);
+    recreatePath(m_workspace.node(meeting.meetForward).pos, out);
+    for (size_t index = meeting.meetBackward;; index = toIndex1D(m_workspace.node(index).parent))
+    {
+        out.push_back(m_workspace.node(index).pos);
+        if (m_workspace.node(index).parent == m_workspace.node(index).pos)
+            break;
+    }
+}
+
+void Pathfinder::packChain(size_t index, PackedPath& out) const
+{
+    // g is the chain length: closed nodes are never reopened, so a parent's g is final when a child takes it
+    for (size_t i = m_workspace.node(index).g; i > 0; i--)
+    {
+        const Node& node = m_workspace.node(index);
+        out.set(i - 1, PackedPath::CodeOf(node.parent, node.pos));
+        index = toIndex1D(node.parent);
+    }
+}
+
+void Pathfinder::recreatePackedPath(const Vec2i& goal, PackedPath& out) const
+{
+    const size_t index = toIndex1D(goal);
+    if (!m_workspace.isSeen(index))
+        return;
+
+    out.resize(m_workspace.node(index).g);
+    packChain(index, out);
+}
+
+void Pathfinder::recreatePackedPath(const Meeting& meeting, PackedPath& out) const
+{
+    if (meeting.length == UINT32_MAX)
+        return;
+
+    out.resize(meeting.length);
+    packChain(meeting.meetForward, out);
+
+    // the backward half already runs towards the goal, its codes come out in order
+    size_t i = m_workspace.node(meeting.meetForward).g;
+    Vec2i from = m_workspace.node(meeting.meetForward).pos;
+    for (size_t index = meeting.meetBackward;; index = toIndex1D(m_workspace.node(index).parent))
+    {
+        const Node& node = m_workspace.node(index);
+        out.set(i++, PackedPath::CodeOf(from, node.pos));
+        if (node.parent == node.pos)
+            break;
+        from = node.pos;
+    }
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <queue>
 #include <vector>
 #include <functional>
@@ -8,6 +10,8 @@
 #include <memory>
 
 #include "Maze.h"
+#include "OpenList.h"
+#include "PackedPath.h"
 
 struct Node
 {
@@ -19,10 +23,138 @@ struct Node
     inline bool operator>(const Node& rhs) const { return (g + h) > (rhs.g + rhs.h); }
 };
 
+/**
+ * @brief Search state that persists across queries
+ *
+ * Every node slot carries the stamp of the query that last touched it, so a new query invalidates
+ * all of them in O(1) by advancing the generation instead of clearing W x H arrays.
+ * Per-query cost is therefore proportional to the nodes the search actually touches.
+ */
+class SearchWorkspace
+{
+public:
+    SearchWorkspace() = default;
+    ~SearchWorkspace() = default;
+
+    // starts a new query over size nodes, allocating only on first use or growth
+    void begin(size_t size);
+    // forgets every node without touching the arrays
+    inline void invalidate() { advance(); }
+
+    inline bool isSeen(size_t index) const { return m_stamps[index] >= m_generation; }
+    // bidirectional searches reuse the two stamp values as "reached from side 0 / side 1", -1 if untouched
+    inline int sideOf(size_t index) const { return m_stamps[index] < m_generation ? -1 : static_cast<int>(m_stamps[index] - m_generation); }
+    inline void markSide(size_t index, int side) { m_stamps[index] = m_generation + side; }
+    inline bool isClosed(size_t index) const { return m_stamps[index] == m_generation + 1; }
+    inline void markOpen(size_t index) { m_stamps[index] = m_generation; }
+    inline void markClosed(size_t index) { m_stamps[index] = m_generation + 1; }
+
+    inline Node& node(size_t index) { return m_nodes[index]; }
+    inline const Node& node(size_t index) const { return m_nodes[index]; }
+
+    // open lists of either policy, kept for their capacity
+    inline HeapOpenList& heap() { return m_heap; }
+    inline BucketOpenList& buckets() { return m_buckets; }
+    // breadth-first layers, [0] and [1] per search side and [2] as the layer being built
+    inline std::vector<uint32_t>& frontier(size_t i) { return m_frontiers[i]; }
+
+    // statistics of the current (or last) query
+    size_t expanded = 0;
+
+private:
+    void advance();
+
+private:
+    std::vector<Node> m_nodes;
+    // m_generation - open, m_generation + 1 - closed, anything lower - untouched by this query
+    std::vector<uint32_t> m_stamps;
+    HeapOpenList m_heap;
+    BucketOpenList m_buckets;
+    std::vector<uint32_t> m_frontiers[3];
+    uint32_t m_generation = 0;
+};
+
+/**
+ * @brief How a Pathfinder searches
+ */
+enum class SearchMode
+{
+    ASTAR,         // unidirectional A* guided by the heuristic
+    BIDIRECTIONAL, // breadth-first from both ends until the frontiers meet, the heuristic is unused
+};
+
+/**
+ * @brief Heuristic functors for the templated search kernel, called directly instead of through std::function
+ */
+struct ManhattanHeuristic
+{
+    inline uint32_t operator()(const Vec2i& lhs, const Vec2i& rhs) const
+    {
+        return static_cast<uint32_t>(std::abs(lhs.x - rhs.x) + std::abs(lhs.y - rhs.y));
+    }
+};
+
+template<typename Fn>
+struct FunctionHeuristic
+{
+    const Fn& fn;
+
+    inline uint32_t operator()(const Vec2i& lhs, const Vec2i& rhs) const { return fn(lhs, rhs); }
+};
+
+/**
+ * @brief Neighbor policy enumerating the passages of a cell from its 4-bit open mask
+ *
+ * A lookup table maps each of the 16 masks to the list of open directions, so a cell costs one load
+ * and a short loop instead of four Vec2i -> Direction conversions and wall tests. Borders need no
+ * checks either: no generated maze ever has a passage leading off the grid.
+ */
+struct OpenMaskNeighbors
+{
+    struct Entry
+    {
+        uint8_t count;
+        uint8_t directions[4]; // indices into DELTAS
+    };
+
+    // NORTH, EAST, SOUTH, WEST - the order the old neighbor array used
+    static constexpr Vec2i DELTAS[4] = { Vec2i(0, -1), Vec2i(1, 0), Vec2i(0, 1), Vec2i(-1, 0) };
+
+    static constexpr std::array<Entry, 16> TABLE = []()
+    {
+        constexpr Direction directions[4] = { Direction::NORTH, Direction::EAST, Direction::SOUTH, Direction::WEST };
+        std::array<Entry, 16> table{};
+        for (uint8_t mask = 0; mask < 16; mask++)
+        {
+            for (uint8_t i = 0; i < 4; i++)
+            {
+                if (mask & static_cast<uint8_t>(directions[i]))
+                    table[mask].directions[table[mask].count++] = i;
+            }
+        }
+        return table;
+    }();
+
+    template<typename Fn>
+    static inline void forEach(const Cell& cell, const Vec2i& pos, Fn&& fn)
+    {
+        const Entry& entry = TABLE[cell.getValue()];
+        for (uint8_t i = 0; i < entry.count; i++)
+        {
+            const Vec2i& delta = DELTAS[entry.directions[i]];
+            fn(Vec2i(pos.x + delta.x, pos.y + delta.y));
+        }
+    }
+};
+
 /**
  * @brief Pathfinder object implementation based on A* algorithm 
  * 
- * TODO: 17.11.22 - this class should be fully rewritten
+ * The search itself is a kernel templated on the heuristic, the neighbor policy and the open list,
+ * so the common Manhattan/open-mask case inlines into a single loop. invoke() stays as the
+ * std::function based entry point and dispatches to that specialization when it is handed Vec2i::Manhattan.
+ *
+ * Queries mutate the workspace, so one Pathfinder must not be shared between threads - see BatchPathfinder.
  */
 class Pathfinder
 {
@@ -30,31 +162,220 @@ public:
     using HeuristicFn = std::function<uint32_t(const Vec2i&, const Vec2i&)>;
 
 public:
-    Pathfinder(const std::shared_ptr<Maze>& maze);
+    Pathfinder(const std::shared_ptr<Maze>& maze, OpenListPolicy policy = OpenListPolicy::BUCKETS, TieBreak tieBreak = TieBreak::LIFO);
     ~Pathfinder() = default;
 
     void reset();
 
+    inline void setOpenListPolicy(OpenListPolicy policy) { m_policy = policy; }
+    inline constexpr OpenListPolicy getOpenListPolicy() const { return m_policy; }
+    inline void setTieBreak(TieBreak tieBreak) { m_workspace.buckets().setTieBreak(tieBreak); }
+    inline void setSearchMode(SearchMode mode) { m_mode = mode; }
+    inline constexpr SearchMode getSearchMode() const { return m_mode; }
+
     std::vector<Vec2i> invoke(const Vec2i& start, const Vec2i& goal, const HeuristicFn& heuristic);
+
+    // compile-time specialized query, heuristic and neighbor enumeration are inlined into the kernel
+    template<typename Heuristic = ManhattanHeuristic, typename Neighbors = OpenMaskNeighbors>
+    std::vector<Vec2i> find(const Vec2i& start, const Vec2i& goal, const Heuristic& heuristic = Heuristic());
+    // same as find, but appends the path to out so many queries can share one buffer; returns the steps appended
+    template<typename Heuristic = ManhattanHeuristic, typename Neighbors = OpenMaskNeighbors>
+    size_t findInto(const Vec2i& start, const Vec2i& goal, std::vector<Vec2i>& out, const Heuristic& heuristic = Heuristic());
+    // same path encoded as 2-bit steps straight from the parent chain, out is overwritten and keeps its capacity
+    template<typename Heuristic = ManhattanHeuristic, typename Neighbors = OpenMaskNeighbors>
+    void findPacked(const Vec2i& start, const Vec2i& goal, PackedPath& out, const Heuristic& heuristic = Heuristic());
+
+    // nodes expanded by the last query
+    inline size_t getExpandedCount() const { return m_workspace.expanded; }
 private:
-    std::vector<Vec2i> recreatePath(const Vec2i& goal) const;
-    inline constexpr bool isValid(const Vec2i& v) const { return v.x < m_dimensions.x && v.y < m_dimensions.y; }
-
-    /**
-     * @param parent a node's position, from which we will be checking the wall
-     * @param neighbor is a move-to node's position, 
-     * 
-     * undefined behavior if length(neighbor - delta) != 1 
-     * 
-     * @return true if it is possible to move from parent to neigbor
-     * @return false if there is no way to move from parent to neighbor
-     */
-    bool isWall(const Vec2i& parent, const Vec2i& neighbor) const;
+    // where the two halves of a bidirectional search touch, meetForward's parents lead to the start
+    // and meetBackward's to the goal
+    struct Meeting
+    {
+        size_t meetForward = 0;
+        size_t meetBackward = 0;
+        uint32_t length = UINT32_MAX; // UINT32_MAX if the halves never met
+    };
+
+    template<typename Heuristic, typename Neighbors>
+    void runSearch(const Vec2i& start, const Vec2i& goal, const Heuristic& heuristic);
+    template<typename Heuristic, typename Neighbors, typename OpenList>
+    void search(OpenList& openList, const Vec2i& start, const Vec2i& goal, const Heuristic& heuristic);
+    template<typename Neighbors>
+    Meeting searchBidirectional(const Vec2i& start, const Vec2i& goal);
+    // appends the start-exclusive path to goal, nothing if the last query never reached it
+    void recreatePath(const Vec2i& goal, std::vector<Vec2i>& out) const;
+    void recreatePath(const Meeting& meeting, std::vector<Vec2i>& out) const;
+    // packed counterparts, out is left empty if the goal was never reached
+    void recreatePackedPath(const Vec2i& goal, PackedPath& out) const;
+    void recreatePackedPath(const Meeting& meeting, PackedPath& out) const;
+    // writes the codes of the parent chain ending at index into out[0, g), last step first
+    void packChain(size_t index, PackedPath& out) const;
     inline constexpr size_t toIndex1D(const Vec2i& v) const { return static_cast<size_t>((v.y * m_dimensions.x) + v.x); };
 
 private:
-    std::vector<Node> m_pathList;
-    std::vector<bool> m_closedList;
+    SearchWorkspace m_workspace;
+    OpenListPolicy m_policy;
+    SearchMode m_mode = SearchMode::ASTAR;
+    Meeting m_meeting;
     Vec2i m_dimensions;
     std::shared_ptr<Maze> m_maze;
-};
\ No newline at end of file
+};
+
+template<typename Heuristic, typename Neighbors>
+std::vector<Vec2i> Pathfinder::find(const Vec2i& start, const Vec2i& goal, const Heuristic& heuristic)
+{
+    std::vector<Vec2i> path;
+    findInto<Heuristic, Neighbors>(start, goal, path, heuristic);
+    return path;
+}
+
+template<typename Heuristic, typename Neighbors>
+size_t Pathfinder::findInto(const Vec2i& start, const Vec2i& goal, std::vector<Vec2i>& out, const Heuristic& heuristic)
+{
+    const size_t first = out.size();
+    runSearch<Heuristic, Neighbors>(start, goal, heuristic);
+
+    if (m_mode == SearchMode::BIDIRECTIONAL)
+        recreatePath(m_meeting, out);
+    else
+        recreatePath(goal, out);
+    return out.size() - first;
+}
+
+template<typename Heuristic, typename Neighbors>
+void Pathfinder::findPacked(const Vec2i& start, const Vec2i& goal, PackedPath& out, const Heuristic& heuristic)
+{
+    runSearch<Heuristic, Neighbors>(start, goal, heuristic);
+
+    out.clear(start);
+    if (m_mode == SearchMode::BIDIRECTIONAL)
+        recreatePackedPath(m_meeting, out);
+    else
+        recreatePackedPath(goal, out);
+}
+
+template<typename Heuristic, typename Neighbors>
+void Pathfinder::runSearch(const Vec2i& start, const Vec2i& goal, const Heuristic& heuristic)
+{
+    m_workspace.begin(static_cast<size_t>(m_dimensions.x) * m_dimensions.y);
+
+    if (m_mode == SearchMode::BIDIRECTIONAL)
+        m_meeting = searchBidirectional<Neighbors>(start, goal);
+    else if (m_policy == OpenListPolicy::BUCKETS)
+        search<Heuristic, Neighbors>(m_workspace.buckets(), start, goal, heuristic);
+    else
+        search<Heuristic, Neighbors>(m_workspace.heap(), start, goal, heuristic);
+}
+
+template<typename Heuristic, typename Neighbors, typename OpenList>
+void Pathfinder::search(OpenList& openList, const Vec2i& start, const Vec2i& goal, const Heuristic& heuristic)
+{
+    size_t startIndex = toIndex1D(start);
+    m_workspace.node(startIndex) = Node{ .pos = start, .parent = start }; // assign start parent to start so we could recreate the path
+    m_workspace.markOpen(startIndex);
+    openList.push(static_cast<uint32_t>(startIndex), 0);
+
+    while (!openList.empty())
+    {
+        // get node with least f value (g + h, to be exact)
+        size_t currentIndex = openList.top();
+        uint32_t currentF = openList.topF();
+        openList.pop();
+
+        // a node may sit in the open list several times, only the entry matching its best f counts
+        const Node& current = m_workspace.node(currentIndex);
+        if (m_workspace.isClosed(currentIndex) || current.g + current.h != currentF)
+            continue;
+
+        const Vec2i currentPos = current.pos;
+        if (currentPos == goal)
+        {
+            break;
+        }
+
+        // Mark node as closed one (as we just traversed it)
+        m_workspace.markClosed(currentIndex);
+        ++m_workspace.expanded;
+        const uint32_t g = current.g + 1;
+
+        Neighbors::forEach(m_maze->cell(currentPos.x, currentPos.y), currentPos, [&](const Vec2i& neighborPos)
+        {
+            size_t index = toIndex1D(neighborPos);
+            if (m_workspace.isClosed(index))
+                return;
+
+            // we count new f, g and h
+            uint32_t h = heuristic(neighborPos, goal);
+            uint32_t f = g + h;
+
+            // if the neighbor wasn't seen by this query yet or we found a shorter way to it
+            // then we assign our f to the node and push it into openList
+            Node& neighbor = m_workspace.node(index);
+            if (!m_workspace.isSeen(index) || f < neighbor.g + neighbor.h)
+            {
+                neighbor = { neighborPos, currentPos, g, h };
+                m_workspace.markOpen(index);
+                openList.push(static_cast<uint32_t>(index), f);
+            }
+        });
+    }
+}
+
+template<typename Neighbors>
+Pathfinder::Meeting Pathfinder::searchBidirectional(const Vec2i& start, const Vec2i& goal)
+{
+    // side 0 grows from the start and its parents point back to it,
+    // side 1 grows from the goal and its parents point towards the goal
+    const Vec2i roots[2] = { start, goal };
+    for (int side = 0; side < 2; side++)
+    {
+        size_t index = toIndex1D(roots[side]);
+        m_workspace.node(index) = Node{ .pos = roots[side], .parent = roots[side] };
+        m_workspace.markSide(index, side);
+        m_workspace.frontier(side).assign(1, static_cast<uint32_t>(index));
+    }
+    Meeting meeting;
+    if (start == goal)
+        return meeting;
+
+    std::vector<uint32_t>& next = m_workspace.frontier(2);
+
+    while (!m_workspace.frontier(0).empty() && !m_workspace.frontier(1).empty())
+    {
+        // grow the smaller frontier by one full layer, a meeting found anywhere in that layer
+        // is only final once the whole layer is done - then the shortest one wins
+        const int side = m_workspace.frontier(0).size() <= m_workspace.frontier(1).size() ? 0 : 1;
+        next.clear();
+
+        for (uint32_t currentIndex : m_workspace.frontier(side))
+        {
+            const Node& current = m_workspace.node(currentIndex);
+            ++m_workspace.expanded;
+
+            Neighbors::forEach(m_maze->cell(current.pos.x, current.pos.y), current.pos, [&](const Vec2i& neighborPos)
+            {
+                size_t index = toIndex1D(neighborPos);
+                int reachedFrom = m_workspace.sideOf(index);
+
+                if (reachedFrom == -1)
+                {
+                    m_workspace.node(index) = { neighborPos, current.pos, current.g + 1, 0 };
+                    m_workspace.markSide(index, side);
+                    next.push_back(static_cast<uint32_t>(index));
+                }
+                else if (reachedFrom != side && current.g + 1 + m_workspace.node(index).g < meeting.length)
+                {
+                    meeting.length = current.g + 1 + m_workspace.node(index).g;
+                    meeting.meetForward = side == 0 ? currentIndex : index;
+                    meeting.meetBackward = side == 0 ? index : currentIndex;
+                }
+            });
+        }
+
+        if (meeting.length != UINT32_MAX)
+            break;
+        std::swap(m_workspace.frontier(side), next);
+    }
+    return meeting;
+}
@@ -0,0 +1,168 @@
+#include "Robot.h"
+
+#include <iostream>
+
+#include "utility/RandomGenerator.h"
+
+size_t RobotGroup::add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal)
+{
+    std::shared_ptr<DistanceField> field = fields->get(goal);
+    field->update();
+
+    m_positions.push_back(start);
+    m_starts.push_back(start);
+    m_goals.push_back(goal);
+    m_fields.push_back(field.get());
+    m_arrived.push_back(0);
+    return m_positions.size() - 1;
+}
+
+void RobotGroup::reset()
+{
+    m_positions = m_starts;
+    std::fill(m_arrived.begin(), m_arrived.end(), uint8_t(0));
+}
+
+void SimpleRobots::plan(ThreadPool* pool, uint64_t)
+{
+    planBlocks(pool, [this](size_t robot, Block& block)
+    {
+        step(robot);
+        block.travelling += !m_arrived[robot];
+    });
+}
+
+size_t BoomRobots::add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal, int32_t chance)
+{
+    m_chances.push_back(std::min(chance, 100));
+    return RobotGroup::add(fields, start, goal);
+}
+
+void BoomRobots::plan(ThreadPool* pool, uint64_t tick)
+{
+    const uint64_t seed = m_maze->getSeed();
+    planBlocks(pool, [&](size_t robot, Block& block)
+    {
+        if (!step(robot))
+            return;
+        block.travelling += !m_arrived[robot];
+
+        if (static_cast<int32_t>(RandomGenerator::generateIndexAt(0, 100, seed, stream(robot), tick)) < m_chances[robot])
+            block.intents.push_back({ static_cast<uint32_t>(robot), m_positions[robot], Vec2i(0) });
+    });
+}
+
+size_t BoomRobots::apply()
+{
+    static constexpr std::array<Vec2i, 4> directions = {
+        Vec2i( 0, -1),
+        Vec2i( 1,  0),
+        Vec2i( 0,  1),
+        Vec2i(-1,  0),
+    };
+
+    return applyBlocks([this](const Intent& intent)
+    {
+        for (const Vec2i& delta : directions) //break a wall in 4 directions
+        {
+            m_maze->breakWall(intent.pos, delta);
+        }
+        if (m_logging)
+            std::cout << "[LOG]: BOOM! BoomRobot has exploded...\n";
+    });
+}
+
+void AngryRobots::plan(ThreadPool* pool, uint64_t)
+{
+    planBlocks(pool, [this](size_t robot, Block& block)
+    {
+        const Vec2i prevpos = m_positions[robot];
+        if (!step(robot))
+            return;
+        block.travelling += !m_arrived[robot];
+        block.intents.push_back({ static_cast<uint32_t>(robot), m_positions[robot], m_positions[robot] - prevpos });
+    });
+}
+
+size_t AngryRobots::apply()
+{
+    // two robots punching the same wall is no conflict: the first one breaks it, the second finds it open
+    return applyBlocks([this](const Intent& intent)
+    {
+        if (m_maze->breakWall(intent.pos, intent.delta) && m_logging)
+        {
+            std::cout << "[LOG]: GRAAAA! AngryRobot has punched wall..\n";
+        }
+    });
+}
+
+size_t SlowRobots::add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal)
+{
+    const size_t robot = RobotGroup::add(fields, start, goal);
+    // drawn from the maze seed rather than the global generator, so worlds can be set up concurrently
+    const uint64_t seed = m_maze->getSeed();
+    m_midPoints.push_back(Vec2i(
+        static_cast<int32_t>(RandomGenerator::generateIndexAt(0, m_maze->getWidth() - 1, seed, stream(robot), 0)),
+        static_cast<int32_t>(RandomGenerator::generateIndexAt(0, m_maze->getHeight() - 1, seed, stream(robot), 1))));
+    m_midPlanners.push_back(std::make_unique<DStarLite>(m_maze, m_midPoints.back()));
+    m_paths.emplace_back();
+    m_progress.push_back(0);
+    m_passedMidPoint.push_back(0);
+    replan(robot);
+    return robot;
+}
+
+void SlowRobots::reset()
+{
+    RobotGroup::reset();
+    std::fill(m_passedMidPoint.begin(), m_passedMidPoint.end(), uint8_t(0));
+    update();
+}
+
+void SlowRobots::update()
+{
+    for (size_t robot = 0; robot < size(); robot++)
+    {
+        if (!m_passedMidPoint[robot])
+            replan(robot);
+    }
+}
+
+void SlowRobots::replan(size_t robot)
+{
+    m_midPlanners[robot]->replan(m_positions[robot], m_paths[robot]);
+    m_progress[robot] = 0;
+}
+
+void SlowRobots::plan(ThreadPool* pool, uint64_t)
+{
+    planBlocks(pool, [this](size_t robot, Block& block)
+    {
+        Vec2i& pos = m_positions[robot];
+        if (!m_passedMidPoint[robot] && m_progress[robot] < m_paths[robot].size())
+        {
+            const Vec2i& delta = PackedPath::DELTAS[m_paths[robot].code(m_progress[robot]++)];
+            pos = Vec2i(pos.x + delta.x, pos.y + delta.y);   //next point
+        }
+        else
+        {
+            m_passedMidPoint[robot] = 1;
+            if (!step(robot))
+                return;
+        }
+        block.travelling += !m_arrived[robot];
+        m_passedMidPoint[robot] |= pos == m_midPoints[robot];
+        // nothing to do to the maze, the intent only carries the log line out of the parallel phase
+        if (m_logging)
+            block.intents.push_back({ static_cast<uint32_t>(robot), pos, Vec2i(0) });
+    });
+}
+
+size_t SlowRobots::apply()
+{
+    return applyBlocks([this](const Intent& intent)
+    {
+        const Vec2i& midPoint = m_midPoints[intent.robot];
+        std::cout << "[LOG]: SlowRobot middle point - " << midPoint.x << " " << midPoint.y << "." << std::endl;
+    });
+}
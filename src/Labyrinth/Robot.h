@@ -1,12 +1,16 @@
 #pragma once
 
 #include <algorithm>
-#include <memory>
 #include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
-#include "utility/RandomGenerator.h"
-#include "Pathfinding.h"
+#include "DStarLite.h"
+#include "DistanceField.h"
 #include "Maze.h"
+#include "PackedPath.h"
+#include "utility/ThreadPool.h"
 
 enum class Robots
 {
@@ -17,249 +21,350 @@ enum class Robots
     UNKNOWN
 };
 
-class IRobot
+/**
+ * @brief Read-only view of one robot, handed out by RobotManager::ForEach
+ */
+struct RobotView
+{
+    Robots type;
+    Vec2i pos;
+    Vec2i goal;
+    bool arrived;
+};
+
+/**
+ * @brief Every robot of one type, stored column by column
+ *
+ * Each attribute lives in its own contiguous array indexed by the robot, so a tick over a group is one
+ * linear pass per column instead of a virtual call per heap-allocated robot. The derived groups add the
+ * columns their type needs; there is no virtual dispatch anywhere.
+ *
+ * A tick runs in two phases. plan() moves every robot against the maze as it was when the tick began,
+ * block by block and possibly in parallel: a robot only writes its own columns, anything it wants done
+ * to the shared maze is queued as an Intent in its block. apply() then carries the intents out on one
+ * thread in block order, which is robot order, so the outcome does not depend on how many threads ran plan().
+ */
+class RobotGroup
 {
 public:
-    IRobot(const std::shared_ptr<Pathfinder>& pathfinder,
-           const std::shared_ptr<Maze>& maze, const Vec2i& start, const Vec2i& goal, const Robots& robotType)
-        : m_pos(start)
-        , m_start(start)
-        , m_maze(maze)
-        , m_goal(goal)
-        , m_finder(pathfinder)
-        , m_robotType(robotType)
-        , m_arrived(false)
-    {
-        UpdatePath();
-    }
-    virtual ~IRobot() = default;
+    static constexpr size_t BLOCK_SIZE = 4096;
 
-    virtual void UpdatePath()
-    {
-        m_path = m_finder->invoke(m_pos, m_goal, Vec2i::Manhattan);
-    }
-    virtual void reset()
-    {
-        m_arrived = false;
-        m_pos = m_start;
-        UpdatePath();
-    }
+public:
+    inline size_t size() const { return m_positions.size(); }
+    inline bool empty() const { return m_positions.empty(); }
 
-    virtual void move() = 0;
+    inline const Vec2i& getPos(size_t robot) const { return m_positions[robot]; }
+    inline const Vec2i& getGoal(size_t robot) const { return m_goals[robot]; }
+    inline bool isArrived(size_t robot) const { return m_arrived[robot] != 0; }
+    // robots that have arrived, or are stuck with no way to their goal
+    inline size_t getArrivedCount() const { return std::count(m_arrived.begin(), m_arrived.end(), uint8_t(1)); }
 
-    inline constexpr Robots getRobotType() const { return m_robotType; }
+    // [LOG] lines for wall breaks, explosions and detours, on by default
+    inline void setLogging(bool logging) { m_logging = logging; }
+    inline bool isLogging() const { return m_logging; }
 
-    inline constexpr Vec2i getPos() const { return m_pos; }
+protected:
+    // a side effect outside the robot's own columns, carried out by apply()
+    struct Intent
+    {
+        uint32_t robot;
+        Vec2i pos;
+        Vec2i delta;
+    };
 
-    inline constexpr Vec2i getGoal() const { return m_goal; }
+    struct Block
+    {
+        std::vector<Intent> intents;
+        size_t travelling = 0; // robots of the block still on their way after this tick
+    };
 
-    inline constexpr bool isArrived() const { return m_arrived; }
 protected:
-    Vec2i m_pos;
-    Vec2i m_start;
-    Vec2i m_goal;
-    std::vector<Vec2i> m_path;
-    std::shared_ptr<Maze> m_maze;
-    std::shared_ptr<Pathfinder> m_finder;
-    Robots m_robotType;
-    bool m_arrived;
-}; // IRobot class
-
-class BoomRobot : public IRobot
-{
-public:
-    BoomRobot(const std::shared_ptr<Pathfinder>& pathfinder,
-    const std::shared_ptr<Maze>& maze, const Vec2i& start, const Vec2i& goal,int32_t chance)
-        : IRobot(pathfinder,maze,start,goal, Robots::BOOM)
-        , m_chance(std::min(chance,100))
+    RobotGroup(const std::shared_ptr<Maze>& maze, Robots type)
+        : m_maze(maze)
+        , m_type(type)
     {
     }
-    virtual ~BoomRobot() = default;
 
-    bool boom()
-    {
-        int32_t result = RandomGenerator::generateIndex(0,100);
+    size_t add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal);
+    // puts every robot back on its start
+    void reset();
 
-        if(!(result < m_chance)){
-            return false;
-        }
+    // runs fn(robot, block) for every robot, blocks in parallel when a pool is given
+    template<typename Fn>
+    void planBlocks(ThreadPool* pool, Fn&& fn)
+    {
+        const size_t blockCount = (size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        m_blocks.resize(blockCount);
 
-        static constexpr std::array<Vec2i, 4> directions = {
-                Vec2i( 0, -1),
-                Vec2i( 1,  0),
-                Vec2i( 0,  1),
-                Vec2i(-1,  0),
-        };
-        for(const Vec2i& delta : directions) //break a wall in 4 directions
+        const auto run = [&](size_t index)
         {
-            m_maze->breakWall(m_pos,delta);
-        }
-        return true;
-    }
+            Block& block = m_blocks[index];
+            block.intents.clear();
+            block.travelling = 0;
+            const size_t end = std::min(size(), (index + 1) * BLOCK_SIZE);
+            for (size_t robot = index * BLOCK_SIZE; robot < end; robot++)
+                fn(robot, block);
+        };
 
-    virtual void move() override
-    {
-        if(m_path.empty())
+        if (pool && blockCount > 1)
         {
-            m_arrived = true;
+            pool->parallelFor(blockCount, run);
             return;
         }
-        m_pos = m_path.front();    //next point
-        m_path.erase(m_path.begin());
-        if(boom())
-        {
-            std::cout << "[LOG]: BOOM! BoomRobot has exploded...\n";
-        }
+        for (size_t index = 0; index < blockCount; index++)
+            run(index);
     }
-private:
-    int32_t m_chance;
-}; // BoomRobot class
-
-class SimpleRobot : public IRobot
-{
-public:
-    SimpleRobot(const std::shared_ptr<Pathfinder>& pathfinder,
-                const std::shared_ptr<Maze>& maze, const Vec2i& start, const Vec2i& goal)
-            : IRobot(pathfinder,maze,start,goal, Robots::SIMPLE)
+    // runs fn(intent) over all blocks in robot order, returns the robots still travelling
+    template<typename Fn>
+    size_t applyBlocks(Fn&& fn)
     {
-    }
-    virtual ~SimpleRobot() = default;
-
-    virtual void move()
-    {
-        if(m_path.empty())
+        size_t travelling = 0;
+        for (const Block& block : m_blocks)
         {
-            m_arrived = true;
-            return;
+            for (const Intent& intent : block.intents)
+                fn(intent);
+            travelling += block.travelling;
         }
+        return travelling;
+    }
 
-        m_pos = m_path.front();  //next point
-        m_path.erase(m_path.begin());
+    // random stream of one robot, distinct across groups
+    inline uint64_t stream(size_t robot) const { return (static_cast<uint64_t>(m_type) << 32) | robot; }
 
-        return;
+    // moves robot one cell down its goal field, marks it arrived instead if there is nowhere to go;
+    // the mark is redone every step, so a robot that was stuck sets off again once a way opens
+    inline bool step(size_t robot)
+    {
+        const Vec2i next = m_fields[robot]->nextStep(m_positions[robot]);
+        m_arrived[robot] = next == m_positions[robot];
+        if (m_arrived[robot])
+            return false;
+        m_positions[robot] = next;
+        return true;
     }
-}; // SimpleRobot class
 
-class SlowRobot : public IRobot
+protected:
+    std::shared_ptr<Maze> m_maze;
+    Robots m_type;
+    std::vector<Vec2i> m_positions;
+    std::vector<Vec2i> m_starts;
+    std::vector<Vec2i> m_goals;
+    // owned by the manager's GoalFields, robots with the same goal point at the same field
+    std::vector<const DistanceField*> m_fields;
+    std::vector<uint8_t> m_arrived;
+    std::vector<Block> m_blocks;
+    bool m_logging = true;
+}; // RobotGroup class
+
+class SimpleRobots : public RobotGroup
 {
 public:
-    SlowRobot(const std::shared_ptr<Pathfinder>& pathfinder,
-              const std::shared_ptr<Maze>& maze, const Vec2i& start, const Vec2i& goal)
-        : IRobot(pathfinder,maze,start,goal, Robots::SLOW),
-        m_midPoint(RandomGenerator::generateCellCoords(m_maze.get()))
+    static constexpr Robots TYPE = Robots::SIMPLE;
+
+    SimpleRobots(const std::shared_ptr<Maze>& maze)
+        : RobotGroup(maze, TYPE)
     {
     }
-    virtual ~SlowRobot() = default;
 
-    virtual void UpdatePath() override
+    inline size_t add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal) { return RobotGroup::add(fields, start, goal); }
+    inline void reset() { RobotGroup::reset(); }
+    inline void update() {}
+    void plan(ThreadPool* pool, uint64_t tick);
+    // returns how many robots are still on their way
+    inline size_t apply() { return applyBlocks([](const Intent&) {}); }
+}; // SimpleRobots class
+
+class BoomRobots : public RobotGroup
+{
+public:
+    static constexpr Robots TYPE = Robots::BOOM;
+
+    BoomRobots(const std::shared_ptr<Maze>& maze)
+        : RobotGroup(maze, TYPE)
     {
-        m_path = m_finder->invoke(m_pos, m_midPoint, Vec2i::Manhattan);
-        std::vector<Vec2i> secondPath = m_finder->invoke(m_midPoint, m_goal, Vec2i::Manhattan);
-        m_path.insert(m_path.end(), secondPath.begin(), secondPath.end());
     }
 
-    virtual void move()
-    {
-        if (m_path.empty())
-        {
-            m_arrived = true;
-            return;
-        }
+    // chance is the percentage of moves that end in an explosion breaking all four walls around the robot
+    size_t add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal, int32_t chance);
+    inline void reset() { RobotGroup::reset(); }
+    inline void update() {}
+    // the explosion roll is keyed by (maze seed, robot, tick), so it does not depend on which thread moves the robot
+    void plan(ThreadPool* pool, uint64_t tick);
+    size_t apply();
 
-        if (m_pos.x == m_goal.x && m_pos.y == m_goal.y)
-        {
-            m_arrived = true;
-            m_path.clear();
-            return;
-        }
+private:
+    std::vector<int32_t> m_chances;
+}; // BoomRobots class
 
-        m_pos = m_path.front();   //next point
-        m_path.erase(m_path.begin());
+class AngryRobots : public RobotGroup
+{
+public:
+    static constexpr Robots TYPE = Robots::ANGRY;
 
-        std::cout << "[LOG]: SlowRobot middle point - " << m_midPoint.x << " " << m_midPoint.y << "." << std::endl;
+    AngryRobots(const std::shared_ptr<Maze>& maze)
+        : RobotGroup(maze, TYPE)
+    {
     }
-private:
-    Vec2i m_midPoint;
 
-}; // SlowRobot class
+    inline size_t add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal) { return RobotGroup::add(fields, start, goal); }
+    inline void reset() { RobotGroup::reset(); }
+    inline void update() {}
+    // every step also punches the wall ahead of the robot
+    void plan(ThreadPool* pool, uint64_t tick);
+    size_t apply();
+}; // AngryRobots class
 
-class AngryRobot : public IRobot
+class SlowRobots : public RobotGroup
 {
 public:
-    AngryRobot(const std::shared_ptr<Pathfinder>& pathfinder, const std::shared_ptr<Maze>& maze, const Vec2i& start, const Vec2i& goal)
-            : IRobot(pathfinder,maze,start,goal, Robots::ANGRY)
-            , m_prevpos(0)
+    static constexpr Robots TYPE = Robots::SLOW;
+
+    SlowRobots(const std::shared_ptr<Maze>& maze)
+        : RobotGroup(maze, TYPE)
     {
     }
-    virtual ~AngryRobot() = default;
 
-    virtual void move()
-    {
-        if (m_path.empty())
-        {
-            m_arrived = true;
-            return;
-        }
-        m_prevpos = m_pos;     //prev point
-        m_pos = m_path.front();    //next point
-        Vec2i delta = m_pos - m_prevpos;
-        if (m_maze->breakWall(m_pos, delta))
-        {
-            std::cout << "[LOG]: GRAAAA! AngryRobot has punched wall..\n";
-        }
-        
-        m_path.erase(m_path.begin());
+    // picks a random midpoint the robot visits before heading for its goal
+    size_t add(const std::shared_ptr<GoalFields>& fields, const Vec2i& start, const Vec2i& goal);
+    void reset();
+    // only the detour to the private midpoint needs a planner of its own, the rest follows the shared goal field
+    void update();
+    void plan(ThreadPool* pool, uint64_t tick);
+    size_t apply();
 
-        return;
-    }
 private:
-    Vec2i m_prevpos;
-}; // AngryRobot class
-
+    void replan(size_t robot);
 
+private:
+    std::vector<Vec2i> m_midPoints;
+    // a planner keeps two arrays the size of the maze, so they stay behind pointers rather than in the column
+    std::vector<std::unique_ptr<DStarLite>> m_midPlanners;
+    std::vector<PackedPath> m_paths;
+    // steps of m_paths already taken
+    std::vector<uint32_t> m_progress;
+    std::vector<uint8_t> m_passedMidPoint;
+}; // SlowRobots class
 
 template<typename T>
-static constexpr bool isRobot = std::is_base_of_v<IRobot, T>;
+static constexpr bool isRobotGroup = std::is_base_of_v<RobotGroup, T>;
 
+/**
+ * @brief Owns every robot, one group per type, and the goal fields they follow
+ *
+ * With a thread pool each tick moves the robots in parallel; the result is the same as without one.
+ */
 class RobotManager
 {
 public:
-    RobotManager(const std::shared_ptr<Maze>& maze,const std::shared_ptr<Pathfinder>& pathfinder)
+    // steps taken by still travelling robots, per Robots type
+    using StepCounts = std::array<size_t, static_cast<size_t>(Robots::UNKNOWN)>;
+
+public:
+    // pool == nullptr ticks on the calling thread
+    RobotManager(const std::shared_ptr<Maze>& maze, std::shared_ptr<ThreadPool> pool = nullptr)
         : m_maze(maze)
-        , m_pathfinder(pathfinder)
+        , m_pool(std::move(pool))
+        , m_fields(std::make_shared<GoalFields>(maze))
+        , m_angry(maze)
+        , m_boom(maze)
+        , m_simple(maze)
+        , m_slow(maze)
     {
     }
-    ~RobotManager()
+    ~RobotManager() = default;
+
+    // adds a robot to group T, returns its index inside that group
+    template<typename T, typename... Args>
+    std::enable_if_t<isRobotGroup<T>, size_t> AddRobot(const Vec2i& start, const Vec2i& goal, Args&&... args)
     {
-        for(IRobot* robot : m_robots)
+        return GetGroup<T>().add(m_fields, start, goal, std::forward<Args>(args)...);
+    }
+
+    // puts every robot back on its start; the maze may have been regenerated, so the goal fields are
+    // brought up to date before anyone moves
+    void Reset()
+    {
+        m_fields->update();
+        forEachGroup([](auto& group) { group.reset(); });
+        m_tick = 0;
+    }
+
+    // one update per distinct goal however many robots share it
+    void UpdatePaths()
+    {
+        m_fields->update();
+        forEachGroup([](auto& group) { group.update(); });
+    }
+
+    // moves every robot once and adds the robots still travelling to steps
+    void Tick(StepCounts& steps)
+    {
+        // every robot moves against the maze as it was when the tick began
+        forEachGroup([&](auto& group) { group.plan(m_pool.get(), m_tick); });
+        // then wall breaks land group by group in robot order
+        forEachGroup([&](auto& group) { steps[static_cast<size_t>(group.TYPE)] += group.apply(); });
+        ++m_tick;
+    }
+
+    template<typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        forEachGroup([&](const auto& group)
         {
-            delete robot;
-        }
+            for (size_t robot = 0; robot < group.size(); robot++)
+                fn(RobotView{ group.TYPE, group.getPos(robot), group.getGoal(robot), group.isArrived(robot) });
+        });
     }
 
-    template<typename T, typename... Args>
-    std::enable_if_t<isRobot<T>, T*> AddRobot(Args&&... args)
+    inline void SetLogging(bool logging)
     {
-        IRobot* robot = m_robots.emplace_back(new T (m_pathfinder, std::forward<Args>(args)...));
-        return (T*) robot;
+        forEachGroup([&](auto& group) { group.setLogging(logging); });
     }
+    inline bool IsLogging() const { return m_simple.isLogging(); }
 
-    void Reset()
+    inline uint64_t GetTick() const { return m_tick; }
+    inline size_t GetRobotCount() const { return m_angry.size() + m_boom.size() + m_simple.size() + m_slow.size(); }
+    inline size_t GetArrivedCount() const { return m_angry.getArrivedCount() + m_boom.getArrivedCount() + m_simple.getArrivedCount() + m_slow.getArrivedCount(); }
+
+    template<typename T>
+    inline T& GetGroup()
     {
-        // clear robots
-        for(IRobot* robot : m_robots)
+        if constexpr (std::is_same_v<T, AngryRobots>) return m_angry;
+        else if constexpr (std::is_same_v<T, BoomRobots>) return m_boom;
+        else if constexpr (std::is_same_v<T, SimpleRobots>) return m_simple;
+        else
         {
-            robot->reset();
+            static_assert(std::is_same_v<T, SlowRobots>, "unknown robot group");
+            return m_slow;
         }
-        m_pathfinder->reset();
-
     }
 
-    inline constexpr std::vector<IRobot*>& GetRobots() { return m_robots; }
-    inline constexpr const std::vector<IRobot*>& GetRobots() const { return m_robots; }
+private:
+    // Robots enum order
+    template<typename Fn>
+    void forEachGroup(Fn&& fn)
+    {
+        fn(m_angry);
+        fn(m_boom);
+        fn(m_simple);
+        fn(m_slow);
+    }
+    template<typename Fn>
+    void forEachGroup(Fn&& fn) const
+    {
+        fn(m_angry);
+        fn(m_boom);
+        fn(m_simple);
+        fn(m_slow);
+    }
 
 private:
-    std::vector<IRobot*> m_robots;
     std::shared_ptr<Maze> m_maze;
-    std::shared_ptr<Pathfinder> m_pathfinder;
-}; // RobotManager class
\ No newline at end of file
+    std::shared_ptr<ThreadPool> m_pool;
+    std::shared_ptr<GoalFields> m_fields;
+    uint64_t m_tick = 0;
+    AngryRobots m_angry;
+    BoomRobots m_boom;
+    SimpleRobots m_simple;
+    SlowRobots m_slow;
+}; // RobotManager class
@@ -0,0 +1,270 @@
+#include "TerminalRenderer.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iostream>
+
+#if defined(_WIN32) || defined(WIN32)
+    #define NOMINMAX
+    #include <Windows.h>
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace
+{
+    // same palette PrintColorful uses, indexed by Robots type; 5 marks goals and shared cells
+    constexpr std::array<std::string_view, 6> COLORS = {
+        "\033[0;34m",
+        "\033[0;32m",
+        "\033[0;36m",
+        "\033[0;31m",
+        "\033[0;35m",
+        "\033[0;33m",
+    };
+    constexpr std::string_view RESET_COLOR = "\033[0m";
+    constexpr std::string_view CLEAR = "\033[H\033[2J";
+    constexpr std::string_view CLEAR_BELOW = "\033[J";
+
+    constexpr std::array<char, static_cast<size_t>(Robots::UNKNOWN)> ROBOT_SYMBOLS = { 'A', 'B', 's', 'S' };
+    constexpr uint8_t SHARED_COLOR = 5;
+
+    void writeAll(int fd, std::string_view bytes)
+    {
+#if defined(_WIN32) || defined(WIN32)
+        // escape sequences need virtual terminal processing, off by default in older consoles
+        static const bool ansi = []()
+        {
+            HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+            DWORD mode = 0;
+            return GetConsoleMode(console, &mode) && SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        }();
+        (void)ansi;
+        _write(fd, bytes.data(), static_cast<unsigned int>(bytes.size()));
+#else
+        while (!bytes.empty())
+        {
+            const ssize_t written = ::write(fd, bytes.data(), bytes.size());
+            if (written <= 0)
+                return;
+            bytes.remove_prefix(static_cast<size_t>(written));
+        }
+#endif
+    }
+}
+
+TerminalRenderer::TerminalRenderer(int fd)
+    : m_fd(fd)
+{
+}
+
+void TerminalRenderer::ClearScreen(int fd)
+{
+    std::cout.flush();
+    writeAll(fd, CLEAR);
+}
+
+void TerminalRenderer::render(const std::shared_ptr<Maze>& maze, const RobotManager& robots)
+{
+    m_dirty.clear();
+    if (maze != m_maze || !m_cursor)
+    {
+        // a fresh cursor is unsynced, which redraws everything below
+        m_cursor.reset();
+        m_maze = maze;
+        m_cursor.emplace(maze->getJournal());
+    }
+
+    // walls are replayed from the journal unless the maze was resized or regenerated since
+    const auto changes = m_cursor->pending();
+    const bool full = !changes || maze->getWidth() != m_width || 2 * maze->getHeight() + 1 != m_rows;
+    if (full)
+    {
+        composeMaze(*maze);
+    }
+    else
+    {
+        for (const MazeChange& change : *changes)
+        {
+            // the opened wall is the north or west wall of the lower right of the two cells
+            const Vec2i pos = change.delta.x + change.delta.y > 0 ? change.pos + change.delta : change.pos;
+            composeWalls(*maze, pos.x, pos.y);
+        }
+    }
+    m_cursor->advance();
+    composeRobots(robots);
+
+    m_output.clear();
+    m_color = NO_COLOR;
+    if (full)
+        emitFull();
+    else
+        emitDiff();
+    finish();
+
+    // anything still buffered in std::cout belongs before this frame
+    std::cout.flush();
+    writeAll(m_fd, m_output);
+}
+
+void TerminalRenderer::setGlyph(size_t row, size_t column, Glyph glyph)
+{
+    const size_t index = row * m_columns + column;
+    if (m_frame[index] == glyph)
+        return;
+    m_frame[index] = glyph;
+    m_dirty.push_back(static_cast<uint32_t>(index));
+}
+
+void TerminalRenderer::composeMaze(const Maze& maze)
+{
+    m_width = maze.getWidth();
+    m_columns = 2 * m_width + 1;
+    m_rows = 2 * maze.getHeight() + 1;
+    m_frame.assign(m_columns * m_rows, Glyph{ '#' });
+    // same size: composeRobots() clears the cells it left occupied, no need to wipe them all
+    if (m_cells.size() != m_width * maze.getHeight())
+    {
+        m_cells.assign(m_width * maze.getHeight(), Occupancy{});
+        m_occupied.clear();
+    }
+
+    // written straight into the frame, emitFull() sends all of it anyway
+    for (size_t y = 0; y < maze.getHeight(); y++)
+    {
+        Glyph* walls = &m_frame[2 * y * m_columns];
+        Glyph* cells = walls + m_columns;
+        for (size_t x = 0; x < m_width; x++)
+        {
+            const Cell& cell = maze.cell(x, y);
+            walls[2 * x + 1].symbol = cell.hasPath(Direction::NORTH) ? ' ' : '#';
+            cells[2 * x].symbol = cell.hasPath(Direction::WEST) ? ' ' : '#';
+            cells[2 * x + 1].symbol = ' ';
+        }
+    }
+}
+
+void TerminalRenderer::composeWalls(const Maze& maze, size_t x, size_t y)
+{
+    const Cell& cell = maze.cell(x, y);
+    setGlyph(2 * y, 2 * x + 1, Glyph{ cell.hasPath(Direction::NORTH) ? ' ' : '#' });
+    setGlyph(2 * y + 1, 2 * x, Glyph{ cell.hasPath(Direction::WEST) ? ' ' : '#' });
+}
+
+void TerminalRenderer::composeRobots(const RobotManager& robots)
+{
+    // forget last frame's counts, the cells are redrawn below whether or not anyone is left on them
+    std::swap(m_occupied, m_vacated);
+    m_occupied.clear();
+    for (uint32_t cell : m_vacated)
+        m_cells[cell] = Occupancy{};
+
+    const auto touch = [&](uint32_t cell) -> Occupancy&
+    {
+        Occupancy& occupancy = m_cells[cell];
+        if (occupancy.count == 0 && !occupancy.goal)
+            m_occupied.push_back(cell);
+        return occupancy;
+    };
+    robots.ForEach([&](const RobotView& robot)
+    {
+        Occupancy& occupancy = touch(static_cast<uint32_t>(robot.pos.y * m_width + robot.pos.x));
+        ++occupancy.count;
+        occupancy.type = robot.type;
+        touch(static_cast<uint32_t>(robot.goal.y * m_width + robot.goal.x)).goal = true;
+    });
+
+    for (uint32_t cell : m_vacated)
+        composeCell(cell);
+    for (uint32_t cell : m_occupied)
+        composeCell(cell);
+}
+
+void TerminalRenderer::composeCell(uint32_t cell)
+{
+    const Occupancy& occupancy = m_cells[cell];
+    Glyph glyph;
+    if (occupancy.count > 1)
+        glyph = { occupancy.count > 9 ? '+' : static_cast<char>('0' + occupancy.count), SHARED_COLOR };
+    else if (occupancy.count == 1)
+        glyph = { ROBOT_SYMBOLS[static_cast<size_t>(occupancy.type)], static_cast<uint8_t>(occupancy.type) };
+    else if (occupancy.goal)
+        glyph = { '0', SHARED_COLOR };
+    setGlyph(2 * (cell / m_width) + 1, 2 * (cell % m_width) + 1, glyph);
+}
+
+void TerminalRenderer::setColor(uint8_t color)
+{
+    if (color == m_color)
+        return;
+    m_output += color == NO_COLOR ? RESET_COLOR : COLORS[color];
+    m_color = color;
+}
+
+void TerminalRenderer::moveCursor(size_t row, size_t column)
+{
+    // CSI row ; column H, both 1-based
+    char digits[24];
+    m_output += "\033[";
+    m_output.append(digits, std::to_chars(digits, digits + sizeof(digits), row + 1).ptr);
+    m_output += ';';
+    m_output.append(digits, std::to_chars(digits, digits + sizeof(digits), column + 1).ptr);
+    m_output += 'H';
+}
+
+void TerminalRenderer::emitFull()
+{
+    // glyphs plus a newline per row, colors come on top
+    m_output.reserve(m_frame.size() + m_rows + CLEAR.size() + 64);
+    m_output += CLEAR;
+    for (size_t row = 0; row < m_rows; row++)
+    {
+        const Glyph* glyphs = &m_frame[row * m_columns];
+        // one color change per run of same-colored glyphs, the symbols of a run are copied in one go
+        for (size_t column = 0; column < m_columns; )
+        {
+            size_t end = column + 1;
+            while (end < m_columns && glyphs[end].color == glyphs[column].color)
+                ++end;
+            setColor(glyphs[column].color);
+            const size_t offset = m_output.size();
+            m_output.resize(offset + end - column);
+            for (char* out = &m_output[offset]; column < end; column++)
+                *out++ = glyphs[column].symbol;
+        }
+        setColor(NO_COLOR);
+        m_output += '\n';
+    }
+    m_changed = m_frame.size();
+}
+
+void TerminalRenderer::emitDiff()
+{
+    // screen order, so runs of neighbors on one row go out without addressing
+    std::sort(m_dirty.begin(), m_dirty.end());
+    m_dirty.erase(std::unique(m_dirty.begin(), m_dirty.end()), m_dirty.end());
+
+    size_t cursor = SIZE_MAX;
+    for (uint32_t index : m_dirty)
+    {
+        const size_t row = index / m_columns;
+        const size_t column = index % m_columns;
+        if (index != cursor)
+            moveCursor(row, column);
+        const Glyph& glyph = m_frame[index];
+        setColor(glyph.color);
+        m_output += glyph.symbol;
+        // the cursor does not wrap onto the next row
+        cursor = column + 1 < m_columns ? index + 1 : SIZE_MAX;
+    }
+    m_changed = m_dirty.size();
+}
+
+void TerminalRenderer::finish()
+{
+    setColor(NO_COLOR);
+    moveCursor(m_rows, 0);
+    m_output += CLEAR_BELOW;
+}
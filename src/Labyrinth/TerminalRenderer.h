@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Maze.h"
+#include "Robot.h"
+
+/**
+ * @brief Draws battles into the terminal one frame buffer at a time
+ *
+ * The renderer keeps the frame that is on screen as a grid of glyphs - walls, robots by type letter,
+ * counts where robots share a cell, '0' on goals - and turns each new frame into ANSI text in one
+ * preallocated buffer that goes out with a single write(). The first frame clears the screen and draws
+ * everything. After that only glyphs that changed are sent, each behind a cursor-addressing sequence,
+ * and only the cells that can have changed are looked at: walls opened since the last frame, read from
+ * the maze journal, and the cells robots stand on or head for. A tick of a 200x200 battle costs
+ * microseconds and a few hundred bytes.
+ *
+ * Every frame leaves the cursor on the line below the maze with the rest of the screen cleared, which is
+ * where log lines end up.
+ */
+class TerminalRenderer
+{
+public:
+    // fd frames are written to, stdout by default
+    explicit TerminalRenderer(int fd = 1);
+    ~TerminalRenderer() = default;
+
+    void render(const std::shared_ptr<Maze>& maze, const RobotManager& robots);
+    // the next render() redraws the whole screen, e.g. after something else printed over the frame
+    inline void invalidate() { m_cursor.reset(); }
+
+    // bytes of the last frame as written
+    inline std::string_view getOutput() const { return m_output; }
+    // glyphs the last frame sent, all of them for a full redraw
+    inline size_t getChangedCount() const { return m_changed; }
+
+    // clears the screen and homes the cursor, without spawning a shell
+    static void ClearScreen(int fd = 1);
+
+private:
+    static constexpr uint8_t NO_COLOR = 0xFF;
+
+    struct Glyph
+    {
+        char symbol = ' ';
+        uint8_t color = NO_COLOR;
+
+        inline bool operator==(const Glyph& rhs) const { return symbol == rhs.symbol && color == rhs.color; }
+    };
+
+    struct Occupancy
+    {
+        uint32_t count = 0;
+        Robots type = Robots::UNKNOWN;
+        bool goal = false;
+    };
+
+    // lays out every wall and clears every cell
+    void composeMaze(const Maze& maze);
+    // north and west wall glyphs of one cell
+    void composeWalls(const Maze& maze, size_t x, size_t y);
+    // recounts the robots and redraws the cells they left or entered
+    void composeRobots(const RobotManager& robots);
+    void composeCell(uint32_t cell);
+    void setGlyph(size_t row, size_t column, Glyph glyph);
+
+    void emitFull();
+    void emitDiff();
+    void setColor(uint8_t color);
+    void moveCursor(size_t row, size_t column);
+    // leaves the cursor below the frame and clears whatever is there
+    void finish();
+
+private:
+    int m_fd;
+    std::shared_ptr<Maze> m_maze;
+    // walls opened since the last frame, empty before the first one
+    std::optional<MazeJournal::Cursor> m_cursor;
+    size_t m_width = 0;
+    size_t m_columns = 0;
+    size_t m_rows = 0;
+
+    // what is on screen once the last frame was written
+    std::vector<Glyph> m_frame;
+    // glyph indices the current frame changed
+    std::vector<uint32_t> m_dirty;
+    std::vector<Occupancy> m_cells;
+    // cells with robots or goals, this frame and the previous one
+    std::vector<uint32_t> m_occupied;
+    std::vector<uint32_t> m_vacated;
+
+    std::string m_output;
+    uint8_t m_color = NO_COLOR;
+    size_t m_changed = 0;
+}; // TerminalRenderer class
@@ -0,0 +1,157 @@
+#include "Tournament.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    constexpr const char* TYPE_NAMES[] = { "angry", "boom", "simple", "slow" };
+
+    // nearest-rank percentile of sorted values
+    double percentile(const std::vector<double>& sorted, double p)
+    {
+        const size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+}
+
+Tournament::Tournament(const TournamentConfig& config, std::shared_ptr<ThreadPool> pool)
+    : m_config(config)
+    , m_pool(pool ? std::move(pool) : std::make_shared<ThreadPool>())
+{
+    if (m_config.lineUp.empty())
+    {
+        const int32_t right = static_cast<int32_t>(m_config.width) - 1;
+        const int32_t bottom = static_cast<int32_t>(m_config.height) - 1;
+        const Vec2i middle(static_cast<int32_t>(m_config.width / 2), static_cast<int32_t>(m_config.height / 2));
+        m_config.lineUp = {
+            { Robots::SLOW, Vec2i(0, 0), middle },
+            { Robots::SIMPLE, Vec2i(0, bottom), middle },
+            { Robots::ANGRY, Vec2i(right, 0), middle },
+            { Robots::BOOM, Vec2i(right, bottom), middle, 30 },
+        };
+    }
+}
+
+BattleReport Tournament::playBattle(size_t battle) const
+{
+    std::shared_ptr<Maze> maze = Maze::Carve(Grid(m_config.width, m_config.height), MazeFactory::DeriveSeed(m_config.baseSeed, battle));
+    // battles already fill the pool, so each one ticks serially
+    BattleContext context(maze);
+    RobotManager& robots = context.GetRobotManager();
+    for (const TournamentEntry& entry : m_config.lineUp)
+    {
+        switch (entry.type)
+        {
+        case Robots::ANGRY: robots.AddRobot<AngryRobots>(entry.start, entry.goal); break;
+        case Robots::BOOM: robots.AddRobot<BoomRobots>(entry.start, entry.goal, entry.chance); break;
+        case Robots::SIMPLE: robots.AddRobot<SimpleRobots>(entry.start, entry.goal); break;
+        case Robots::SLOW: robots.AddRobot<SlowRobots>(entry.start, entry.goal); break;
+        default: break;
+        }
+    }
+    return context.RunHeadless(m_config.maxTicks);
+}
+
+TournamentSummary Tournament::run()
+{
+    const auto begin = std::chrono::steady_clock::now();
+
+    m_reports.assign(m_config.battles, BattleReport{});
+    m_pool->parallelFor(m_config.battles, [this](size_t battle) { m_reports[battle] = playBattle(battle); });
+
+    TournamentSummary summary;
+    summary.battles = m_config.battles;
+    for (const TournamentEntry& entry : m_config.lineUp)
+    {
+        if (entry.type != Robots::UNKNOWN)
+            ++summary.types[static_cast<size_t>(entry.type)].robots;
+    }
+
+    std::array<std::vector<double>, static_cast<size_t>(Robots::UNKNOWN)> samples;
+    for (const BattleReport& report : m_reports)
+    {
+        summary.ticks += report.ticks;
+        summary.unfinished += !report.finished;
+        // a battle stopped at maxTicks only holds cut-off step counts, they would drag every statistic
+        // towards the tick limit
+        if (!report.finished)
+            continue;
+
+        double best = std::numeric_limits<double>::max();
+        std::array<double, static_cast<size_t>(Robots::UNKNOWN)> perRobot{};
+        for (size_t type = 0; type < perRobot.size(); type++)
+        {
+            if (summary.types[type].robots == 0)
+                continue;
+            perRobot[type] = static_cast<double>(report.steps[type]) / summary.types[type].robots;
+            samples[type].push_back(perRobot[type]);
+            best = std::min(best, perRobot[type]);
+        }
+        for (size_t type = 0; type < perRobot.size(); type++)
+        {
+            if (summary.types[type].robots != 0 && perRobot[type] == best)
+                ++summary.types[type].wins;
+        }
+    }
+
+    for (size_t type = 0; type < samples.size(); type++)
+    {
+        std::vector<double>& values = samples[type];
+        if (values.empty())
+            continue;
+        std::sort(values.begin(), values.end());
+
+        TournamentStats& stats = summary.types[type];
+        double sum = 0.0;
+        for (double value : values)
+            sum += value;
+        stats.mean = sum / values.size();
+        stats.p50 = percentile(values, 50.0);
+        stats.p90 = percentile(values, 90.0);
+        stats.p99 = percentile(values, 99.0);
+        stats.min = values.front();
+        stats.max = values.back();
+    }
+
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return summary;
+}
+
+void TournamentSummary::writeCsv(std::ostream& os) const
+{
+    os << "type,robots,mean,p50,p90,p99,min,max,wins\n";
+    for (size_t type = 0; type < types.size(); type++)
+    {
+        const TournamentStats& stats = types[type];
+        if (stats.robots == 0)
+            continue;
+        os << TYPE_NAMES[type] << ',' << stats.robots << ',' << stats.mean << ',' << stats.p50 << ',' << stats.p90 << ','
+           << stats.p99 << ',' << stats.min << ',' << stats.max << ',' << stats.wins << '\n';
+    }
+}
+
+void TournamentSummary::writeJson(std::ostream& os) const
+{
+    os << "{\n";
+    os << "  \"battles\": " << battles << ",\n";
+    os << "  \"unfinished\": " << unfinished << ",\n";
+    os << "  \"ticks\": " << ticks << ",\n";
+    os << "  \"seconds\": " << seconds << ",\n";
+    os << "  \"types\": {";
+    bool first = true;
+    for (size_t type = 0; type < types.size(); type++)
+    {
+        const TournamentStats& stats = types[type];
+        if (stats.robots == 0)
+            continue;
+        os << (first ? "\n" : ",\n");
+        first = false;
+        os << "    \"" << TYPE_NAMES[type] << "\": { \"robots\": " << stats.robots << ", \"mean\": " << stats.mean
+           << ", \"p50\": " << stats.p50 << ", \"p90\": " << stats.p90 << ", \"p99\": " << stats.p99
+           << ", \"min\": " << stats.min << ", \"max\": " << stats.max << ", \"wins\": " << stats.wins << " }";
+    }
+    os << "\n  }\n}\n";
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "Battle.h"
+#include "utility/ThreadPool.h"
+
+/**
+ * @brief One robot of the line-up every tournament world starts with
+ */
+struct TournamentEntry
+{
+    Robots type;
+    Vec2i start;
+    Vec2i goal;
+    int32_t chance = 0; // BoomRobots only
+};
+
+struct TournamentConfig
+{
+    size_t battles = 1000;
+    size_t width = 20;
+    size_t height = 20;
+    uint32_t baseSeed = 1;
+    // a battle still running after this many ticks is stopped and counted as unfinished
+    size_t maxTicks = 10000;
+    // empty picks Main's four robots: one of each type from the corners to the middle
+    std::vector<TournamentEntry> lineUp;
+};
+
+/**
+ * @brief Step statistics of one Robots type over every battle of a tournament
+ *
+ * Steps are per robot of the type in a battle, so line-ups with several robots of a type stay comparable.
+ * Only finished battles are sampled, the ones stopped at maxTicks are just counted in TournamentSummary::unfinished.
+ */
+struct TournamentStats
+{
+    size_t robots = 0; // of this type per battle, 0 if the type sits the tournament out
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    // battles this type arrived in with the fewest steps, a tie counts for every type in it
+    size_t wins = 0;
+};
+
+struct TournamentSummary
+{
+    std::array<TournamentStats, static_cast<size_t>(Robots::UNKNOWN)> types{};
+    size_t battles = 0;
+    size_t unfinished = 0;
+    size_t ticks = 0; // over all battles
+    double seconds = 0.0;
+
+    inline double getBattlesPerSecond() const { return seconds > 0.0 ? battles / seconds : 0.0; }
+
+    void writeCsv(std::ostream& os) const;
+    void writeJson(std::ostream& os) const;
+};
+
+/**
+ * @brief Plays many independent battles concurrently and aggregates how each robot type fared
+ *
+ * Battle i runs in a world of its own: a maze carved from MazeFactory::DeriveSeed(baseSeed, i) - the
+ * maze CarveBatch would give it - plus its own robots and goal fields, played headless to the end.
+ * Worlds share nothing mutable, so they are spread over the pool one battle per item, and since every
+ * random draw is keyed by the maze seed the summary is the same for any thread count.
+ */
+class Tournament
+{
+public:
+    // pool == nullptr creates one of hardware_concurrency() threads
+    Tournament(const TournamentConfig& config, std::shared_ptr<ThreadPool> pool = nullptr);
+    ~Tournament() = default;
+
+    TournamentSummary run();
+
+    // result of the last run(), one per battle
+    inline const std::vector<BattleReport>& getReports() const { return m_reports; }
+    inline const TournamentConfig& getConfig() const { return m_config; }
+
+private:
+    BattleReport playBattle(size_t battle) const;
+
+private:
+    TournamentConfig m_config;
+    std::shared_ptr<ThreadPool> m_pool;
+    std::vector<BattleReport> m_reports;
+};
@@ -0,0 +1,216 @@
+#include "utility/MappedFile.h"
+
+#include <system_error>
+#include <utility>
+
+#if defined(_WIN32) || defined(WIN32)
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32) || defined(WIN32)
+
+static std::system_error lastError(const char* what)
+{
+    return std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path, Mode mode)
+{
+    DWORD access = mode == Mode::READ_WRITE ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ;
+    m_file = CreateFileW(path.c_str(), access, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+        throw lastError("MappedFile: cannot open file");
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(m_file, &size))
+    {
+        std::system_error error = lastError("MappedFile: cannot stat file");
+        unmap();
+        throw error;
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+    map(mode != Mode::READ_ONLY, mode == Mode::READ_WRITE);
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path, size_t size)
+    : m_size(size)
+{
+    m_file = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE)
+        throw lastError("MappedFile: cannot create file");
+
+    // CreateFileMapping grows the file to the mapping size, new bytes read as zero
+    map(true, true);
+}
+
+void MappedFile::map(bool writable, bool shared)
+{
+    if (m_size == 0)
+        return;
+
+    DWORD protect = !writable ? PAGE_READONLY : (shared ? PAGE_READWRITE : PAGE_WRITECOPY);
+    DWORD access = !writable ? FILE_MAP_READ : (shared ? FILE_MAP_WRITE : FILE_MAP_COPY);
+    ULARGE_INTEGER size;
+    size.QuadPart = m_size;
+
+    m_mapping = CreateFileMappingW(m_file, nullptr, protect, size.HighPart, size.LowPart, nullptr);
+    if (!m_mapping)
+    {
+        std::system_error error = lastError("MappedFile: cannot create file mapping");
+        unmap();
+        throw error;
+    }
+    m_data = static_cast<std::byte*>(MapViewOfFile(m_mapping, access, 0, 0, m_size));
+    if (!m_data)
+    {
+        std::system_error error = lastError("MappedFile: cannot map file");
+        unmap();
+        throw error;
+    }
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mapping)
+        CloseHandle(m_mapping);
+    if (m_file && m_file != INVALID_HANDLE_VALUE)
+        CloseHandle(m_file);
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+}
+
+void MappedFile::flush()
+{
+    if (m_data && !FlushViewOfFile(m_data, m_size))
+        throw lastError("MappedFile: flush failed");
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_file(std::exchange(other.m_file, nullptr))
+    , m_mapping(std::exchange(other.m_mapping, nullptr))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_file = std::exchange(other.m_file, nullptr);
+        m_mapping = std::exchange(other.m_mapping, nullptr);
+    }
+    return *this;
+}
+
+#else
+
+static std::system_error lastError(const char* what)
+{
+    return std::system_error(errno, std::generic_category(), what);
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path, Mode mode)
+{
+    m_fd = ::open(path.c_str(), mode == Mode::READ_WRITE ? O_RDWR : O_RDONLY);
+    if (m_fd < 0)
+        throw lastError("MappedFile: cannot open file");
+
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0)
+    {
+        std::system_error error = lastError("MappedFile: cannot stat file");
+        unmap();
+        throw error;
+    }
+    m_size = static_cast<size_t>(st.st_size);
+    map(mode != Mode::READ_ONLY, mode == Mode::READ_WRITE);
+}
+
+MappedFile::MappedFile(const std::filesystem::path& path, size_t size)
+    : m_size(size)
+{
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0)
+        throw lastError("MappedFile: cannot create file");
+
+    // a freshly extended file is sparse, its pages read as zero until written
+    if (::ftruncate(m_fd, static_cast<off_t>(size)) != 0)
+    {
+        std::system_error error = lastError("MappedFile: cannot resize file");
+        unmap();
+        throw error;
+    }
+    map(true, true);
+}
+
+void MappedFile::map(bool writable, bool shared)
+{
+    if (m_size == 0)
+        return;
+
+    int protect = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* data = ::mmap(nullptr, m_size, protect, shared ? MAP_SHARED : MAP_PRIVATE, m_fd, 0);
+    if (data == MAP_FAILED)
+    {
+        std::system_error error = lastError("MappedFile: cannot map file");
+        unmap();
+        throw error;
+    }
+    m_data = static_cast<std::byte*>(data);
+}
+
+void MappedFile::unmap() noexcept
+{
+    if (m_data)
+        ::munmap(m_data, m_size);
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_data = nullptr;
+    m_fd = -1;
+}
+
+void MappedFile::flush()
+{
+    if (m_data && ::msync(m_data, m_size, MS_SYNC) != 0)
+        throw lastError("MappedFile: flush failed");
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_fd(std::exchange(other.m_fd, -1))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_fd = std::exchange(other.m_fd, -1);
+    }
+    return *this;
+}
+
+#endif // _WIN32 || WIN32
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+/**
+ * @brief RAII wrapper around a memory-mapped file
+ *
+ * Pages are brought in by the OS on first touch and written back (or dropped) under memory pressure,
+ * so a mapping may be much larger than physical memory. Errors are reported as std::system_error.
+ */
+class MappedFile
+{
+public:
+    enum class Mode
+    {
+        READ_ONLY,      // existing file, writes are not allowed
+        READ_WRITE,     // existing file, writes go back to the file
+        COPY_ON_WRITE,  // existing file, writes stay private to this mapping
+    };
+
+public:
+    // maps an existing file in its entirety
+    MappedFile(const std::filesystem::path& path, Mode mode);
+    // creates (or truncates) a zero-filled file of the given size and maps it read-write
+    MappedFile(const std::filesystem::path& path, size_t size);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    inline std::byte* data() noexcept { return m_data; }
+    inline const std::byte* data() const noexcept { return m_data; }
+    inline size_t size() const noexcept { return m_size; }
+
+    // synchronously writes dirty pages back to the file
+    void flush();
+
+private:
+    void map(bool writable, bool shared);
+    void unmap() noexcept;
+
+private:
+    std::byte* m_data = nullptr;
+    size_t m_size = 0;
+#if defined(_WIN32) || defined(WIN32)
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
@@ -1,28 +1,33 @@
 #include "RandomGenerator.h"
 
-void RandomGenerator::setSeed(uint32_t seed)
+#include <random>
+
+void Xoshiro256::jump()
 {
-    if (seed > 0)
-    {
-        m_seed = seed;
-    }
-    else
+    static constexpr uint64_t JUMP[] = { 0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull };
+
+    uint64_t state[4] = { 0, 0, 0, 0 };
+    for (uint64_t word : JUMP)
     {
-        m_seed = m_randDevice();
+        for (int bit = 0; bit < 64; bit++)
+        {
+            if (word & (uint64_t(1) << bit))
+            {
+                for (int i = 0; i < 4; i++)
+                    state[i] ^= m_state[i];
+            }
+            (*this)();
+        }
     }
-
-    std::mt19937 gen(m_seed);
-    m_randGenerator = gen;
+    for (int i = 0; i < 4; i++)
+        m_state[i] = state[i];
 }
 
-size_t RandomGenerator::generateIndex(size_t from, size_t to, uint32_t seed)
+uint32_t RandomGenerator::resolveSeed(uint32_t seed)
 {
-    std::uniform_int_distribution<size_t> randDist(from, to);
-    return randDist(m_randGenerator);
+    // a local device: callers may be on any thread
+    std::random_device device;
+    while (seed == 0)
+        seed = device();
+    return seed;
 }
-
-Vec2i RandomGenerator::generateCellCoords(Maze* maze)
-{
-    return { static_cast<int32_t>(generateIndex(0, maze->getWidth() - 1)),
-    static_cast<int32_t>(generateIndex(0, maze->getHeight() - 1))};
-}
\ No newline at end of file
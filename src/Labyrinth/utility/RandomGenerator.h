@@ -1,8 +1,122 @@
 #pragma once
-#include <random>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
-#include "Maze.h"
+#if defined(_MSC_VER) && defined(_M_X64) && !defined(__SIZEOF_INT128__)
+    #include <intrin.h>
+#endif
 
+/**
+ * @brief xoshiro256** - small, fast generator with 2^256 - 1 period, one instance per owner
+ *
+ * Every maze, carving worker or battle world owns its own engine instead of sharing a global one.
+ * Independent streams come from stream(seed, index), which seeds through splitmix64 so nearby indices
+ * give unrelated states, or from jump(), which advances by 2^128 draws for sequential splitting.
+ * Satisfies UniformRandomBitGenerator, so it also plugs into the standard algorithms.
+ */
+class Xoshiro256
+{
+public:
+    using result_type = uint64_t;
+
+public:
+    explicit Xoshiro256(uint64_t seed = 0)
+    {
+        for (uint64_t& word : m_state)
+            word = SplitMix64(seed);
+    }
+
+    // engine for stream index of seed, streams of one seed never overlap in practice
+    static inline Xoshiro256 stream(uint64_t seed, uint64_t index)
+    {
+        uint64_t key = seed ^ (index * 0xD1B54A32D192ED03ull);
+        return Xoshiro256(SplitMix64(key));
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    inline result_type operator()()
+    {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Uniform value in [0, range), Lemire's multiply-shift with rejection
+     *
+     * One multiplication per draw in the common case; the division only runs for the rare low products
+     * that could be biased, unlike uniform_int_distribution which divides on every call.
+     */
+    inline uint64_t bounded(uint64_t range)
+    {
+        uint64_t low;
+        uint64_t high = MulHigh((*this)(), range, low);
+        if (low < range)
+        {
+            const uint64_t threshold = -range % range;
+            while (low < threshold)
+                high = MulHigh((*this)(), range, low);
+        }
+        return high;
+    }
+    // uniform value in [from, to]
+    inline size_t index(size_t from, size_t to) { return from + static_cast<size_t>(bounded(to - from + 1)); }
+
+    // advances the engine by 2^128 draws
+    void jump();
+
+    // splitmix64 step, also the finalizer behind the stateless draws
+    static inline uint64_t SplitMix64(uint64_t& state)
+    {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // high 64 bits of the full 128-bit product a * b, the low 64 bits go to low
+    static inline uint64_t MulHigh(uint64_t a, uint64_t b, uint64_t& low)
+    {
+#if defined(__SIZEOF_INT128__)
+        const __uint128_t product = static_cast<__uint128_t>(a) * b;
+        low = static_cast<uint64_t>(product);
+        return static_cast<uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        uint64_t high;
+        low = _umul128(a, b, &high);
+        return high;
+#else
+        // four 32x32 -> 64 products, the middle sum cannot overflow
+        const uint64_t aLow = a & 0xFFFFFFFFull, aHigh = a >> 32;
+        const uint64_t bLow = b & 0xFFFFFFFFull, bHigh = b >> 32;
+        const uint64_t lowLow = aLow * bLow;
+        const uint64_t lowHigh = aLow * bHigh;
+        const uint64_t highLow = aHigh * bLow;
+        const uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFull) + (highLow & 0xFFFFFFFFull);
+        low = (middle << 32) | (lowLow & 0xFFFFFFFFull);
+        return aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+    }
+
+private:
+    static inline constexpr uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+private:
+    uint64_t m_state[4];
+};
+
+/**
+ * @brief Seeding helpers and stateless draws, there is no global engine behind them
+ */
 class RandomGenerator
 {
 public:
@@ -11,13 +125,15 @@ public:
     RandomGenerator(const RandomGenerator& randomGenerator) = delete;
     RandomGenerator operator=(const RandomGenerator& randomGenerator) = delete;
 
-    static void setSeed(uint32_t seed = 0);
+    // seed itself, or a fresh non-zero one from std::random_device if seed is 0
+    static uint32_t resolveSeed(uint32_t seed);
 
-    static size_t generateIndex(size_t from, size_t to, uint32_t seed = 0);
-    static Vec2i generateCellCoords(Maze* maze);
-
-private:
-    static inline std::random_device m_randDevice;
-    static inline std::random_device::result_type m_seed;
-    static inline std::mt19937 m_randGenerator;
-};
\ No newline at end of file
+    // stateless draw in [from, to] keyed by (seed, stream, counter): the same key gives the same value on any thread
+    static inline size_t generateIndexAt(size_t from, size_t to, uint64_t seed, uint64_t stream, uint64_t counter)
+    {
+        uint64_t key = seed ^ (stream * 0x9E3779B97F4A7C15ull) ^ (counter * 0xD1B54A32D192ED03ull);
+        // multiply-shift without the rejection step: the bias is below range / 2^64
+        uint64_t low;
+        return from + static_cast<size_t>(Xoshiro256::MulHigh(Xoshiro256::SplitMix64(key), to - from + 1, low));
+    }
+};
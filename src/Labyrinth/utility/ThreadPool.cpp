@@ -0,0 +1,112 @@
+#include "utility/ThreadPool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_workers.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; i++)
+    {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& fn)
+{
+    const std::function<void(size_t, size_t)> job = [&fn](size_t index, size_t) { fn(index); };
+    parallelFor(count, job);
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn)
+{
+    if (count == 0)
+        return;
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_job = &fn;
+        m_count = count;
+        m_next = 0;
+        m_error = nullptr;
+        ++m_generation;
+        ++m_busy; // the calling thread
+    }
+    m_wake.notify_all();
+
+    runItems(0);
+
+    std::unique_lock lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_job = nullptr;
+
+    if (m_error)
+        std::rethrow_exception(m_error);
+}
+
+void ThreadPool::runItems(size_t thread)
+{
+    std::unique_lock lock(m_mutex);
+    const std::function<void(size_t, size_t)>& fn = *m_job;
+
+    while (m_next < m_count)
+    {
+        size_t index = m_next++;
+        lock.unlock();
+
+        try
+        {
+            fn(index, thread);
+        }
+        catch (...)
+        {
+            lock.lock();
+            if (!m_error)
+                m_error = std::current_exception();
+            // no point in starting more items
+            m_next = m_count;
+            continue;
+        }
+
+        lock.lock();
+    }
+
+    if (--m_busy == 0)
+        m_done.notify_all();
+}
+
+void ThreadPool::workerLoop(size_t thread)
+{
+    size_t seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stopping || (m_job && m_generation != seenGeneration); });
+            if (m_stopping)
+                return;
+
+            seenGeneration = m_generation;
+            ++m_busy;
+        }
+
+        runItems(thread);
+    }
+}
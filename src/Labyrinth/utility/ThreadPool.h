@@ -0,0 +1,58 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Fixed set of worker threads for data-parallel loops
+ *
+ * Work is handed out index by index from a shared counter, so uneven items balance themselves.
+ * The calling thread takes part in the loop, a pool of N threads therefore runs N - 1 workers.
+ */
+class ThreadPool
+{
+public:
+    // 0 picks std::thread::hardware_concurrency()
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    inline size_t getThreadCount() const { return m_workers.size() + 1; }
+
+    /**
+     * @brief Calls fn(i) for every i in [0, count) and blocks until all calls returned
+     *
+     * The first exception thrown by fn is rethrown here once the loop has drained.
+     * Not reentrant: fn must not call parallelFor on the same pool.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& fn);
+    // same, fn(i, thread) also gets the index in [0, getThreadCount()) of the thread running it (0 = caller),
+    // for per-thread scratch state that needs no locking
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    void workerLoop(size_t thread);
+    void runItems(size_t thread);
+
+private:
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    // current job, guarded by m_mutex except for the index counter
+    const std::function<void(size_t, size_t)>* m_job = nullptr;
+    size_t m_count = 0;
+    size_t m_next = 0;
+    size_t m_generation = 0;
+    size_t m_busy = 0;
+    std::exception_ptr m_error;
+    bool m_stopping = false;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstdlib>
+#include <ostream>
 #include "utility/Direction.h"
 
 template<typename T>
@@ -39,6 +41,19 @@ public:
     template<typename U>
     explicit operator Vec2<U>() const { return Vec2<U>(static_cast<U>(this->x), static_cast<U>(this->y)); }
 
+    // unit step in the given direction, zero for Direction::UNKNOWN
+    static constexpr Vec2 FromDirection(Direction dir)
+    {
+        switch (dir)
+        {
+        case Direction::NORTH: return { 0, -1};
+        case Direction::EAST:  return { 1,  0};
+        case Direction::SOUTH: return { 0,  1};
+        case Direction::WEST:  return {-1,  0};
+        default:               return { 0,  0};
+        }
+    }
+
     static Vec2 Delta(const Vec2& lhs, const Vec2<T>& rhs) { return {lhs.x - rhs.x, lhs.y - rhs.y}; }
 
     // https://en.wikipedia.org/wiki/Taxicab_geometry